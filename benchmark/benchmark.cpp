@@ -0,0 +1,277 @@
+// 所有生成器在不同规模和稠密度下的性能测试，用gen.hpp中的旧实现作为对照
+// 编译：g++ -O2 -std=c++17 -pthread -I.. benchmark.cpp -o benchmark (需要testlib.h)
+// 运行：./benchmark [budget=10] [max_n=10000000] [max_m=20000000] [class=类名] > result.jsonl
+// 每组参数在单独的子进程里生成，超过budget秒记为timeout，同一个类和稠密度下更大的n不再测试
+// 每行输出一个JSON对象：impl,class,density,n,m,status,gen_s,output_s,edges,edges_per_s,peak_rss_kb，
+// graphgen.h的生成器还有phase_s：GetStats()中各阶段的耗时(没有计时的阶段为0)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "gen.hpp"
+// 打开graphgen.h的统计，记录每个阶段的耗时
+#define GRAPHGEN_STATS
+#include "graphgen.h"
+
+struct Result {
+    double gen = 0, output = 0;                   // 生成和输出的时间(秒)
+    long long edges = 0;                          // 输出的边数
+    bool staged = false;                          // 是否有分阶段的耗时
+    double phase[generator::PHASE_COUNT] = {0};  // 每个阶段的耗时(秒)
+};
+struct Case {
+    std::string name;                               // 类名
+    std::string impl;                               // graphgen.h或gen.hpp
+    std::function<long long(long long)> max_edges;  // n个点时能生成的最多边数
+    std::function<long long(long long)> min_edges;  // n个点时至少的边数
+    std::function<void(int, long long, FILE*, Result&)> run;
+};
+using Clock = std::chrono::steady_clock;
+double Since(Clock::time_point t) { return std::chrono::duration<double>(Clock::now() - t).count(); }
+
+// graphgen.h的生成器：生成后用Output输出
+template <typename G>
+void Measure(G& g, std::function<void(G&)> gen, FILE* out, Result& r) {
+    g.SetNodeLimit(2e9);
+    g.SetEdgeLimit(2e9);
+    auto t = Clock::now();
+    gen(g);
+    r.gen = Since(t);
+    t = Clock::now();
+    g.Output(out);
+    fflush(out);
+    r.output = Since(t);
+    r.edges = g.GetEdge().size();
+    r.staged = true;
+    for (int i = 0; i < generator::PHASE_COUNT; i++) {
+        r.phase[i] = g.GetStats().time[i];
+    }
+}
+// gen.hpp的生成器：没有输出函数，用同样的Writer输出GetEdge()
+template <typename G>
+void MeasureLegacy(G& g, std::function<void(G&)> gen, FILE* out, Result& r) {
+    auto t = Clock::now();
+    gen(g);
+    r.gen = Since(t);
+    t = Clock::now();
+    {
+        generator::Writer w(out);
+        for (auto x : g.GetEdge()) {
+            w.WriteLine({x.first, x.second});
+        }
+    }
+    fflush(out);
+    r.output = Since(t);
+    r.edges = g.GetEdge().size();
+}
+
+long long Complete(long long n) { return n * (n - 1) / 2; }
+long long TreeEdge(long long n) { return n - 1; }
+long long Zero(long long) { return 0; }
+long long GridMax(long long n) {
+    long long x = sqrt(n), y = (n + x - 1) / x;
+    return x * (y - 1) + y * (x - 1) - 2 * ((y - n % y) % y);
+}
+long long CactusMax(long long n) { return n - 1 + (n - 1) / 2; }
+
+std::vector<Case> AllCase() {
+    std::vector<Case> res;
+    // 生成函数只依赖(n,m)的类
+    auto graph = [&](std::string name, auto make, auto max, auto min) {
+        using G = decltype(make(1, 0LL));
+        res.push_back({name, "graphgen.h", max, min, [=](int n, long long m, FILE* out, Result& r) {
+                           G g = make(n, m);
+                           Measure<G>(g, [](G& x) { x.GenGraph(); }, out, r);
+                       }});
+    };
+    auto tree = [&](std::string name, auto make) {
+        using G = decltype(make(1));
+        res.push_back({name, "graphgen.h", TreeEdge, TreeEdge, [=](int n, long long, FILE* out, Result& r) {
+                           G g = make(n);
+                           Measure<G>(g, [](G& x) { x.GenTree(); }, out, r);
+                       }});
+    };
+    auto legacy = [&](std::string name, auto make, auto max, auto min, auto gen) {
+        using G = decltype(make(1, 0LL));
+        res.push_back({name, "gen.hpp", max, min, [=](int n, long long m, FILE* out, Result& r) {
+                           G g = make(n, m);
+                           MeasureLegacy<G>(g, gen, out, r);
+                       }});
+    };
+    auto gen_graph = [](auto& g) { g.GenGraph(); };
+    auto gen_tree = [](auto& g) { g.GenTree(); };
+
+    tree("Tree", [](int n) { return generator::Tree(n); });
+    tree("Chain", [](int n) { return generator::Chain(n); });
+    tree("Flower", [](int n) { return generator::Flower(n); });
+    tree("HeightTree", [](int n) { return generator::HeightTree(n, std::max(2, (int)sqrt(n))); });
+    graph("Graph", [](int n, long long m) { return generator::Graph(n, m); }, Complete, Zero);
+    graph("BipartiteGraph", [](int n, long long m) { return generator::BipartiteGraph(n, m, n / 2); },
+          [](long long n) { return (n / 2) * (n - n / 2); }, Zero);
+    graph("DAG", [](int n, long long m) { return generator::DAG(n, m); }, Complete, Zero);
+    graph("LayerDAG", [](int n, long long m) { return generator::LayerDAG(n, m, std::min(n, 16)); },
+          [](long long n) { return (long long)(Complete(n) * 0.8); }, TreeEdge);
+    graph("CycleGraph", [](int n, long long) { return generator::CycleGraph(n); },
+          [](long long n) { return n; }, [](long long n) { return n; });
+    graph("WheelGraph", [](int n, long long) { return generator::WheelGraph(n); },
+          [](long long n) { return 2 * n - 2; }, [](long long n) { return 2 * n - 2; });
+    graph("GridGraph", [](int n, long long m) { return generator::GridGraph(n, m); }, GridMax, TreeEdge);
+    graph("PseudoTree", [](int n, long long) { return generator::PseudoTree(n); },
+          [](long long n) { return n; }, [](long long n) { return n; });
+    graph("Cactus", [](int n, long long m) { return generator::Cactus(n, m); }, CactusMax, TreeEdge);
+    graph("RegularGraph", [](int n, long long m) { return generator::RegularGraph(n, std::max(1LL, 2 * m / n)); },
+          [](long long n) { return (long long)(Complete(n) * 0.9); }, [](long long n) { return n / 2; });
+    graph("ChungLuGraph", [](int n, long long m) { return generator::ChungLuGraph(n, m); },
+          [](long long n) { return Complete(n) / 4; }, Zero);
+    graph("PreferentialGraph", [](int n, long long m) { return generator::PreferentialGraph(n, m); },
+          [](long long n) { return Complete(n) / 4; }, TreeEdge);
+    graph("RMatGraph", [](int n, long long m) { return generator::RMatGraph(n, m); },
+          [](long long n) { return Complete(n) / 4; }, Zero);
+    graph("PlanarGraph", [](int n, long long m) { return generator::PlanarGraph(n, m); },
+          [](long long n) { return 3 * n - 6; }, TreeEdge);
+    graph("SCCGraph", [](int n, long long m) { return generator::SCCGraph(n, m, std::max(1, n / 100)); },
+          [](long long n) { return (long long)(Complete(n) * 0.9); }, [](long long n) { return n; });
+    graph("BlockCutGraph", [](int n, long long m) { return generator::BlockCutGraph(n, m, 0, -1); },
+          [](long long n) { return (long long)(Complete(n) * 0.9); }, [](long long n) { return n; });
+    graph("DegreeGraph",
+          [](int n, long long m) {
+              int d = std::min<long long>(n - 1, 2 * m / n);
+              std::vector<int> degree(n, d);
+              degree[0] -= (long long)n * d % 2;
+              return generator::DegreeGraph(degree);
+          },
+          [](long long n) { return Complete(n); }, Zero);
+
+    legacy("Tree", [](int n, long long) { return Generator::UnrootTree(n); }, TreeEdge, TreeEdge, gen_tree);
+    legacy("Chain", [](int n, long long) { return Generator::UnrootChain(n); }, TreeEdge, TreeEdge, gen_tree);
+    legacy("Flower", [](int n, long long) { return Generator::UnrootFlower(n); }, TreeEdge, TreeEdge, gen_tree);
+    legacy("Graph", [](int n, long long m) { return Generator::Graph(n, m); }, Complete, Zero, gen_graph);
+    legacy("BipartiteGraph", [](int n, long long m) { return Generator::BipartiteGraph(n, m); },
+           [](long long n) { return (n / 2) * (n - n / 2); }, Zero, gen_graph);
+    legacy("DAG", [](int n, long long m) { return Generator::DAG(n, m); }, Complete, Zero, gen_graph);
+    legacy("CycleGraph", [](int n, long long) { return Generator::CycleGraph(n); },
+           [](long long n) { return n; }, [](long long n) { return n; }, gen_graph);
+    legacy("WheelGraph", [](int n, long long) { return Generator::WheelGraph(n); },
+           [](long long n) { return 2 * n - 2; }, [](long long n) { return 2 * n - 2; }, gen_graph);
+    legacy("GridGraph", [](int n, long long m) { return Generator::GridGraph(n, m); }, GridMax, TreeEdge, gen_graph);
+    legacy("PseudoTree", [](int n, long long) { return Generator::PseudoTree(n); },
+           [](long long n) { return n; }, [](long long n) { return n; }, gen_graph);
+    legacy("Cactus", [](int n, long long m) { return Generator::Cactus(n, m); }, CactusMax, TreeEdge, gen_graph);
+    return res;
+}
+
+int main(int argc, char* argv[]) {
+    registerGen(argc, argv, 1);
+    double budget = 10;
+    long long max_n = 1e7, max_m = 2e7;
+    std::string only;
+    for (int i = 1; i < argc; i++) {
+        std::string s = argv[i];
+        size_t eq = s.find('=');
+        std::string key = s.substr(0, eq), value = eq == std::string::npos ? "" : s.substr(eq + 1);
+        if (key == "budget") {
+            budget = atof(value.c_str());
+        } else if (key == "max_n") {
+            max_n = atoll(value.c_str());
+        } else if (key == "max_m") {
+            max_m = atoll(value.c_str());
+        } else if (key == "class") {
+            only = value;
+        }
+    }
+    // 稀疏：2n条边；稠密：n*sqrt(n)条边；接近完全：上限的90%，都截断到每个类的范围内
+    std::vector<std::pair<std::string, std::function<long long(long long, long long)>>> density = {
+        {"sparse", [](long long n, long long) { return 2 * n; }},
+        {"dense", [](long long n, long long) { return (long long)(n * sqrt(n)); }},
+        {"near-complete", [](long long, long long max) { return (long long)(max * 0.9); }},
+    };
+    std::map<std::string, bool> stop;  // 某个实现/类/稠密度已经超时
+    for (auto& c : AllCase()) {
+        if (!only.empty() && c.name != only) {
+            continue;
+        }
+        std::vector<long long> done;  // 同一个n下已经测过的边数，稠密度截断后可能重复
+        for (long long n = 1000; n <= max_n; n *= 10) {
+            done.clear();
+            for (auto& d : density) {
+                long long max = c.max_edges(n), m = std::max(c.min_edges(n), std::min(max, d.second(n, max)));
+                std::string id = c.impl + "/" + c.name + "/" + d.first;
+                if (m > max_m || std::find(done.begin(), done.end(), m) != done.end()) {
+                    continue;
+                }
+                done.push_back(m);
+                printf("{\"impl\":\"%s\",\"class\":\"%s\",\"density\":\"%s\",\"n\":%lld,\"m\":%lld,",
+                       c.impl.c_str(), c.name.c_str(), d.first.c_str(), n, m);
+                if (stop[id]) {
+                    printf("\"status\":\"skipped\"}\n");
+                    fflush(stdout);
+                    continue;
+                }
+                fprintf(stderr, "%s n=%lld m=%lld\n", id.c_str(), n, m);
+                int fd[2];
+                if (pipe(fd) != 0) {
+                    perror("pipe");
+                    return 1;
+                }
+                pid_t pid = fork();
+                if (pid == 0) {
+                    // 子进程：生成失败时FailGen会输出到stdout，所以把stdout重定向掉
+                    close(fd[0]);
+                    FILE* null = fopen("/dev/null", "w");
+                    dup2(fileno(null), STDOUT_FILENO);
+                    alarm((unsigned)ceil(budget));
+                    Result r;
+                    c.run(n, m, null, r);
+                    // 父进程只读一次，结果要一次写完
+                    char res[512];
+                    int k = snprintf(res, sizeof(res), "%.6f %.6f %lld %d", r.gen, r.output, r.edges, (int)r.staged);
+                    for (double x : r.phase) {
+                        k += snprintf(res + k, sizeof(res) - k, " %.6f", x);
+                    }
+                    dprintf(fd[1], "%s", res);
+                    _exit(0);
+                }
+                close(fd[1]);
+                char buf[512] = {0};
+                ssize_t len = read(fd[0], buf, sizeof(buf) - 1);
+                close(fd[0]);
+                int status;
+                struct rusage usage;
+                wait4(pid, &status, 0, &usage);
+                Result r;
+                int staged = 0, pos = 0;
+                if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && len > 0 &&
+                    sscanf(buf, "%lf %lf %lld %d%n", &r.gen, &r.output, &r.edges, &staged, &pos) == 4) {
+                    printf("\"status\":\"ok\",\"gen_s\":%.6f,\"output_s\":%.6f,\"edges\":%lld,"
+                           "\"edges_per_s\":%.0f,",
+                           r.gen, r.output, r.edges, r.edges / std::max(r.gen, 1e-9));
+                    if (staged) {
+                        printf("\"phase_s\":{");
+                        for (int i = 0, k = 0; i < generator::PHASE_COUNT; i++, pos += k) {
+                            if (sscanf(buf + pos, "%lf%n", &r.phase[i], &k) != 1) {
+                                break;
+                            }
+                            printf("%s\"%s\":%.6f", i ? "," : "", generator::phase_name[i], r.phase[i]);
+                        }
+                        printf("},");
+                    }
+                    printf("\"peak_rss_kb\":%ld}\n", usage.ru_maxrss);
+                } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+                    stop[id] = true;
+                    printf("\"status\":\"timeout\",\"peak_rss_kb\":%ld}\n", usage.ru_maxrss);
+                } else {
+                    printf("\"status\":\"fail\",\"peak_rss_kb\":%ld}\n", usage.ru_maxrss);
+                }
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
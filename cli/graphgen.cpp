@@ -0,0 +1,426 @@
+// 命令行生成器：按描述串生成图并输出，不用为每组数据单独写main和编译
+// 编译：g++ -O2 -std=c++17 -pthread -I.. graphgen.cpp -o graphgen (需要testlib.h)
+// 运行：./graphgen Graph n=100000 m=200000 connect=1 seed=1 out=1.in
+//       ./graphgen -f spec.txt     每行一个描述串，空行和#开头的行忽略，"-f -"从标准输入读
+// 描述串：类名后跟若干key=value，用空格分隔
+//   通用：n m seed out(默认标准输出) header(nm/n/none，树默认n，图默认nm) begin(第一个结点的编号)
+//         direction multiply_edge self_loop connect (0或1，类禁用的标志不能设置)
+//         weight=l,r(均匀边权) geometric=p[,l](几何分布边权)
+//   各类：Tree/Chain/Flower: rooted root   HeightTree: height root   BipartiteGraph: left
+//         LayerDAG: layer source sink span   GridGraph: row anti_spfa anti_dijkstra   Pseudo*: size
+//         RegularGraph: d   ChungLuGraph: gamma max_degree   PreferentialGraph: max_degree
+//         RMatGraph: noise scramble   PlanarGraph: range   SCCGraph/ComponentGraph/Forest: k
+//         BlockCutGraph: bridge cut block   DegreeGraph: degree=d1,d2,... 或 out_degree= in_degree= swap
+//         DynamicGraph: q ratio=add,remove,query (初始图之后输出一行q，再输出q个操作)
+// 没有seed时用描述串的哈希作为种子，同一个描述串总是生成同一个图
+// 某个描述串失败时输出错误信息到stderr并继续处理后面的，最后有失败时返回1
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "graphgen.h"
+
+using namespace generator;
+
+// 一个描述串：类名和key=value参数，记录用过的参数以便发现拼错的key
+class Spec {
+   private:
+    std::map<std::string, std::string> value;
+    std::set<std::string> used;
+
+   public:
+    std::string name;  // 类名
+    std::string text;  // 原始描述串
+    explicit Spec(const std::string& s) : text(s) {
+        std::istringstream in(s);
+        in >> name;
+        std::string token;
+        while (in >> token) {
+            size_t eq = token.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                throw std::runtime_error("expected key=value, but found \"" + token + "\"");
+            }
+            value[token.substr(0, eq)] = token.substr(eq + 1);
+        }
+    }
+    bool Has(const std::string& key) { return value.count(key); }
+    std::string String(const std::string& key, const std::string& def = "") {
+        used.insert(key);
+        return value.count(key) ? value[key] : def;
+    }
+    long long Int(const std::string& key, long long def) {
+        std::string s = String(key);
+        if (s.empty()) {
+            return def;
+        }
+        char* end;
+        long long x = strtoll(s.c_str(), &end, 10);
+        if (*end) {
+            throw std::runtime_error(key + " must be an integer");
+        }
+        return x;
+    }
+    long long Need(const std::string& key) {
+        if (!Has(key)) {
+            throw std::runtime_error(name + " needs " + key);
+        }
+        return Int(key, 0);
+    }
+    double Real(const std::string& key, double def) {
+        std::string s = String(key);
+        return s.empty() ? def : atof(s.c_str());
+    }
+    template <typename T>
+    std::vector<T> List(const std::string& key) {
+        std::vector<T> res;
+        std::string s = String(key);
+        for (size_t i = 0; i < s.size();) {
+            size_t j = s.find(',', i);
+            if (j == std::string::npos) {
+                j = s.size();
+            }
+            res.push_back((T)atof(s.substr(i, j - i).c_str()));
+            i = j + 1;
+        }
+        return res;
+    }
+    /**
+     * 有没用过的key时报错
+     */
+    void CheckUnused() {
+        for (auto& [k, v] : value) {
+            if (!used.count(k)) {
+                throw std::runtime_error(name + " does not accept " + k);
+            }
+        }
+    }
+};
+
+// 检测类有没有可用的(没有被delete的)标志设置函数
+#define GRAPHGEN_HAS(method)                                                                   \
+    template <typename G, typename = void>                                                     \
+    struct Has##method : std::false_type {};                                                   \
+    template <typename G>                                                                      \
+    struct Has##method<G, std::void_t<decltype(std::declval<G&>().method(true))>> : std::true_type {};
+GRAPHGEN_HAS(SetDirection)
+GRAPHGEN_HAS(SetMultiplyEdge)
+GRAPHGEN_HAS(SetSelfLoop)
+GRAPHGEN_HAS(SetConnect)
+
+// 设置一个标志，类禁用了这个标志时报错
+template <bool enable, typename F>
+void ApplyFlag(Spec& s, const char* key, F set) {
+    if (!s.Has(key)) {
+        return;
+    }
+    if constexpr (enable) {
+        set(s.Int(key, 0) != 0);
+    } else {
+        throw std::runtime_error(s.name + " does not accept " + key);
+    }
+}
+
+/**
+ * 设置通用参数，生成后把图输出到w
+ * @param gen 生成函数
+ * @param tree 是否为树，决定默认的输出头
+ * @param n 输出头里的点数，-1表示用参数n
+ */
+template <typename G, typename F>
+void Run(G& g, Spec& s, Writer& w, F gen, bool tree, long long n = -1) {
+    g.SetNodeLimit(2e9);
+    g.SetEdgeLimit(2e9);
+    g.SetBeginNode(s.Int("begin", 1));
+    if constexpr (!std::is_base_of_v<Tree, G>) {
+        ApplyFlag<HasSetDirection<G>::value>(s, "direction", [&](bool f) {
+            if constexpr (HasSetDirection<G>::value) g.SetDirection(f);
+        });
+        ApplyFlag<HasSetMultiplyEdge<G>::value>(s, "multiply_edge", [&](bool f) {
+            if constexpr (HasSetMultiplyEdge<G>::value) g.SetMultiplyEdge(f);
+        });
+        ApplyFlag<HasSetSelfLoop<G>::value>(s, "self_loop", [&](bool f) {
+            if constexpr (HasSetSelfLoop<G>::value) g.SetSelfLoop(f);
+        });
+        ApplyFlag<HasSetConnect<G>::value>(s, "connect", [&](bool f) {
+            if constexpr (HasSetConnect<G>::value) g.SetConnect(f);
+        });
+    }
+    if (s.Has("weight")) {
+        std::vector<long long> r = s.List<long long>("weight");
+        if (r.size() != 2) {
+            throw std::runtime_error("weight must be l,r");
+        }
+        g.SetWeight(r[0], r[1]);
+    }
+    if (s.Has("geometric")) {
+        std::vector<double> r = s.List<double>("geometric");
+        g.SetGeometricWeight(r[0], r.size() > 1 ? (long long)r[1] : 1);
+    }
+    std::string header = s.String("header", tree ? "n" : "nm");
+    s.String("n");
+    s.String("m");
+    s.CheckUnused();
+    gen();
+    if (n == -1) {
+        n = s.Int("n", 0);
+    }
+    if (header == "nm") {
+        w.WriteLine({n, g.GetEdgeCount()});
+    } else if (header == "n") {
+        w.WriteLine({n});
+    } else if (header != "none") {
+        throw std::runtime_error("header must be nm, n or none");
+    }
+    g.Output(w);
+}
+
+// 类名到生成函数的表，生成函数负责构造对象、设置类特有的参数并调用Run
+std::map<std::string, std::function<void(Spec&, Writer&)>> Table() {
+    std::map<std::string, std::function<void(Spec&, Writer&)>> t;
+    auto tree = [&](const char* name, auto make) {
+        t[name] = [make](Spec& s, Writer& w) {
+            int n = s.Need("n");
+            bool rooted = s.Int("rooted", 0);
+            auto g = make(n, rooted, (int)s.Int("root", -1));
+            Run(g, s, w, [&] { g.GenTree(); }, true);
+        };
+    };
+    tree("Tree", [](int n, bool r, int rt) { return Tree(n, r, rt); });
+    tree("Chain", [](int n, bool r, int rt) { return Chain(n, r, rt); });
+    tree("Flower", [](int n, bool r, int rt) { return Flower(n, r, rt); });
+    t["HeightTree"] = [](Spec& s, Writer& w) {
+        HeightTree g(s.Need("n"), s.Int("height", -1), s.Int("root", -1));
+        Run(g, s, w, [&] { g.GenTree(); }, true);
+    };
+    t["Forest"] = [](Spec& s, Writer& w) {
+        Forest g(s.Need("n"), s.Int("k", -1));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["Graph"] = [](Spec& s, Writer& w) {
+        Graph g(s.Need("n"), s.Need("m"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["BipartiteGraph"] = [](Spec& s, Writer& w) {
+        BipartiteGraph g(s.Need("n"), s.Need("m"), s.Int("left", -1));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["DAG"] = [](Spec& s, Writer& w) {
+        DAG g(s.Need("n"), s.Need("m"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["LayerDAG"] = [](Spec& s, Writer& w) {
+        LayerDAG g(s.Need("n"), s.Need("m"), s.Int("layer", -1));
+        g.SetSource(s.Int("source", -1));
+        g.SetSink(s.Int("sink", -1));
+        g.SetSpan(s.Int("span", -1));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["CycleGraph"] = [](Spec& s, Writer& w) {
+        CycleGraph g(s.Need("n"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["WheelGraph"] = [](Spec& s, Writer& w) {
+        WheelGraph g(s.Need("n"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["GridGraph"] = [](Spec& s, Writer& w) {
+        GridGraph g(s.Need("n"), s.Need("m"));
+        if (s.Has("row")) {
+            g.SetRow(s.Int("row", 1));
+        }
+        if (s.Has("anti_spfa")) {
+            g.SetAntiSPFA(s.Int("anti_spfa", 1));
+        }
+        if (s.Has("anti_dijkstra")) {
+            g.SetAntiDijkstra(s.Int("anti_dijkstra", 2));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    auto pseudo = [&](const char* name, auto make) {
+        t[name] = [make](Spec& s, Writer& w) {
+            auto g = make(s.Need("n"));
+            int size = s.Int("size", -1);
+            Run(g, s, w, [&] { g.GenGraph(size); }, false);
+        };
+    };
+    pseudo("PseudoTree", [](int n) { return PseudoTree(n); });
+    pseudo("PseudoInTree", [](int n) { return PseudoInTree(n); });
+    pseudo("PseudoOutTree", [](int n) { return PseudoOutTree(n); });
+    t["Cactus"] = [](Spec& s, Writer& w) {
+        Cactus g(s.Need("n"), s.Need("m"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["RegularGraph"] = [](Spec& s, Writer& w) {
+        RegularGraph g(s.Need("n"), s.Need("d"));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["ChungLuGraph"] = [](Spec& s, Writer& w) {
+        ChungLuGraph g(s.Need("n"), s.Need("m"), s.Real("gamma", 2.5));
+        if (s.Has("max_degree")) {
+            g.SetMaxDegree(s.Int("max_degree", 0));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["PreferentialGraph"] = [](Spec& s, Writer& w) {
+        PreferentialGraph g(s.Need("n"), s.Need("m"));
+        if (s.Has("max_degree")) {
+            g.SetMaxDegree(s.Int("max_degree", 0));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["RMatGraph"] = [](Spec& s, Writer& w) {
+        RMatGraph g(s.Need("n"), s.Need("m"));
+        if (s.Has("noise")) {
+            g.SetNoise(s.Real("noise", 0));
+        }
+        if (s.Has("scramble")) {
+            g.SetScramble(s.Int("scramble", 1));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["PlanarGraph"] = [](Spec& s, Writer& w) {
+        PlanarGraph g(s.Need("n"), s.Need("m"));
+        if (s.Has("range")) {
+            g.SetRange(s.Int("range", 0));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["SCCGraph"] = [](Spec& s, Writer& w) {
+        SCCGraph g(s.Need("n"), s.Need("m"), s.Int("k", -1));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["ComponentGraph"] = [](Spec& s, Writer& w) {
+        ComponentGraph g(s.Need("n"), s.Need("m"), s.Int("k", -1));
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["BlockCutGraph"] = [](Spec& s, Writer& w) {
+        BlockCutGraph g(s.Need("n"), s.Need("m"), s.Int("bridge", 0), s.Int("cut", -1));
+        if (s.Has("block")) {
+            g.SetBlock(s.Int("block", -1));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+    };
+    t["DynamicGraph"] = [](Spec& s, Writer& w) {
+        int q = s.Need("q");
+        DynamicGraph g(s.Need("n"), s.Int("m", 0), q);
+        if (s.Has("ratio")) {
+            std::vector<double> r = s.List<double>("ratio");
+            if (r.size() != 3) {
+                throw std::runtime_error("ratio must be add,remove,query");
+            }
+            g.SetRatio(r[0], r[1], r[2]);
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false);
+        w.WriteLine({q});
+        g.OutputOperation(w);
+    };
+    t["DegreeGraph"] = [](Spec& s, Writer& w) {
+        DegreeGraph g;
+        std::vector<int> d = s.List<int>(s.Has("degree") ? "degree" : "out_degree");
+        if (s.Has("degree")) {
+            g.SetDegree(d);
+        } else {
+            g.SetDegree(d, s.List<int>("in_degree"));
+        }
+        if (s.Has("swap")) {
+            g.SetSwap(s.Int("swap", -1));
+        }
+        Run(g, s, w, [&] { g.GenGraph(); }, false, d.size());
+    };
+    return t;
+}
+
+/**
+ * 64位FNV-1a哈希，不依赖标准库的实现，保证同一个描述串在不同平台上得到同一个种子
+ */
+unsigned long long Fnv1a(const std::string& s) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (unsigned char c : s) {
+        h = (h ^ c) * 1099511628211ULL;
+    }
+    return h;
+}
+/**
+ * 处理一个描述串，出错时抛出异常
+ */
+void Process(const std::string& line, std::map<std::string, std::function<void(Spec&, Writer&)>>& table) {
+    Spec s(line);
+    auto it = table.find(s.name);
+    if (it == table.end()) {
+        throw std::runtime_error("unknown class " + s.name);
+    }
+    rnd.setSeed(s.Has("seed") ? s.Int("seed", 0) : (long long)Fnv1a(line));
+    std::string out = s.String("out");
+    FILE* file = out.empty() ? stdout : fopen(out.c_str(), "w");
+    if (!file) {
+        throw std::runtime_error("can not open " + out);
+    }
+    try {
+        Writer w(file);
+        it->second(s, w);
+    } catch (...) {
+        // 失败的描述串不留下不完整的文件
+        if (file != stdout) {
+            fclose(file);
+            remove(out.c_str());
+        }
+        throw;
+    }
+    if (file != stdout) {
+        fclose(file);
+    } else {
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    registerGen(argc, argv, 1);
+    fail_throw = true;
+    std::vector<std::string> specs;
+    if (argc >= 3 && strcmp(argv[1], "-f") == 0) {
+        std::ifstream file;
+        if (strcmp(argv[2], "-") != 0) {
+            file.open(argv[2]);
+            if (!file) {
+                fprintf(stderr, "can not open %s\n", argv[2]);
+                return 1;
+            }
+        }
+        std::istream& in = strcmp(argv[2], "-") == 0 ? std::cin : file;
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t i = line.find_first_not_of(" \t\r");
+            if (i != std::string::npos && line[i] != '#') {
+                specs.push_back(line);
+            }
+        }
+    } else if (argc >= 2) {
+        std::string line;
+        for (int i = 1; i < argc; i++) {
+            line += (i > 1 ? " " : "") + std::string(argv[i]);
+        }
+        specs.push_back(line);
+    } else {
+        fprintf(stderr, "usage: %s Class key=value ... | %s -f spec.txt\n", argv[0], argv[0]);
+        return 1;
+    }
+    auto table = Table();
+    int fail = 0;
+    for (size_t i = 0; i < specs.size(); i++) {
+        try {
+            Process(specs[i], table);
+        } catch (std::exception& e) {
+            fail++;
+            std::string msg = e.what();
+            while (!msg.empty() && msg.back() == '\n') {
+                msg.pop_back();
+            }
+            fprintf(stderr, "spec %zu (%s): %s\n", i + 1, specs[i].c_str(), msg.c_str());
+        }
+    }
+    return fail ? 1 : 0;
+}
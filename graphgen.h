@@ -1,9 +1,46 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "testlib.h"
 
+#ifdef GRAPHGEN_COUNT_ALLOC
+// 统计堆分配的次数，用于确认重复生成时不再分配内存；只能在一个源文件里定义这个宏
+std::atomic<long long> alloc_count(0);
+void* operator new(size_t size) {
+    alloc_count++;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#endif
+
+// 为true时FailGen抛出std::runtime_error而不是结束程序，见generator::Batch；每个线程各自设置
+thread_local bool fail_throw = false;
+
 void FailGen(const char* msg, ...) {
-    printf("\033[31mFAIL!\033[0m \n");
     va_list value;
     va_start(value, msg);
+    if (fail_throw) {
+        char buf[1024];
+        vsnprintf(buf, sizeof(buf), msg, value);
+        va_end(value);
+        throw std::runtime_error(buf);
+    }
+    printf("\033[31mFAIL!\033[0m \n");
     vfprintf(stdout, msg, value);
     va_end(value);
     exit(EXIT_FAILURE);
@@ -11,701 +48,5239 @@ void FailGen(const char* msg, ...) {
 
 namespace generator {
 
-// 一颗随机生成的树,默认为无根
-class Tree {
-   protected:
-    unsigned int node_limit = 1e6;  // 结点数的上限
-    unsigned int edge_limit = 1e6;  // 边数的上限
-    int begin_node = 1;             // 结点开始编号
-    int node;                       // 结点数
-    // 是否是有根树,默认为false,如果是有根树的话，边为(father,son);否则边为(father,son)与(son,father)中的任意一个
-    bool is_root;
-    int root;                               // 根，默认为1,只在is_rooted=1的时候生效
-    std::vector<std::pair<int, int>> edge;  // 边
-    std::vector<int> p;
-    void JudgeLimits() {
-        if (node <= 0) {
-            FailGen("node must be a positive integer.\n");
+// 当前线程使用的随机数生成器，库内的随机数都从这里取
+// 默认为testlib的rnd，Suite在工作线程中换成每个任务自己的生成器
+thread_local random_t* thread_rnd = &::rnd;
+
+// 与testlib的shuffle相同，但使用当前线程的生成器
+template <typename It>
+void Shuffle(It first, It last) {
+    if (first == last) {
+        return;
+    }
+    for (It i = first + 1; i != last; ++i) {
+        std::iter_swap(i, first + thread_rnd->next(int(i - first) + 1));
+    }
+}
+
+// 开放寻址的整数哈希集合，用于无放回采样和边的去重
+class HashSet {
+   private:
+    static constexpr unsigned long long EMPTY = ~0ULL;  // 空位标记
+    std::vector<unsigned long long> table;
+    unsigned long long mask;
+    size_t count;
+
+   public:
+    // 哈希函数(splitmix64)，EdgeSet也使用它
+    static unsigned long long Hash(unsigned long long x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    /**
+     * @param n 预计插入的元素个数
+     */
+    HashSet(size_t n = 0) { Reset(n); }
+    /**
+     * 清空集合并按预计元素个数重新分配空间
+     * @param n 预计插入的元素个数
+     */
+    void Reset(size_t n) {
+        size_t cap = 16;
+        while (cap < 2 * n) {
+            cap <<= 1;
         }
-        if (node > node_limit) {
-            FailGen(
-                "node must less than or equal to %d, or you can change the "
-                "node_limit.\n",
-                node_limit);
+        table.assign(cap, EMPTY);
+        mask = cap - 1;
+        count = 0;
+    }
+    /**
+     * 插入元素
+     * @return 是否为新插入的元素
+     * @attention 元素不能为~0ULL
+     */
+    bool Insert(unsigned long long x) {
+        unsigned long long i = Hash(x) & mask;
+        while (table[i] != EMPTY) {
+            if (table[i] == x) {
+                return false;
+            }
+            i = (i + 1) & mask;
         }
-        if (is_root && (root < 0 || root > node - 1)) {
-            FailGen("restriction of the root is [%d,%d]\n", begin_node,
-                    node - 1 + begin_node);
+        table[i] = x;
+        count++;
+        return true;
+    }
+    /**
+     * 查询元素是否存在
+     */
+    bool Count(unsigned long long x) const {
+        unsigned long long i = Hash(x) & mask;
+        while (table[i] != EMPTY) {
+            if (table[i] == x) {
+                return true;
+            }
+            i = (i + 1) & mask;
         }
+        return false;
     }
-    void Init() {
-        if (is_root) {
-            root -= begin_node;
+    /**
+     * 删除元素，后面的元素前移填补空位
+     * @return 元素是否存在
+     */
+    bool Erase(unsigned long long x) {
+        unsigned long long i = Hash(x) & mask;
+        while (table[i] != x) {
+            if (table[i] == EMPTY) {
+                return false;
+            }
+            i = (i + 1) & mask;
         }
-        JudgeLimits();
-        edge.clear();
-        p = rnd.perm(node, 0);
-        if (is_root) {
-            for (int i = 0; i < node; i++) {
-                if (p[i] == root) {
-                    std::swap(p[0], p[i]);
-                    break;
-                }
+        unsigned long long j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (table[j] == EMPTY) {
+                break;
+            }
+            unsigned long long k = Hash(table[j]) & mask;
+            // k不在(i,j]之间时，table[j]可以移到i
+            if ((i < j) ? (k <= i || k > j) : (k <= i && k > j)) {
+                table[i] = table[j];
+                i = j;
             }
         }
+        table[i] = EMPTY;
+        count--;
+        return true;
     }
-    void AddEdge(int u, int v) {
-        u += begin_node;
-        v += begin_node;
-        if (is_root || rnd.next(2)) {
-            edge.push_back({u, v});
-        } else {
-            edge.push_back({v, u});
+    size_t Size() const { return count; }
+    /**
+     * 哈希表的槽数
+     */
+    size_t Capacity() const { return table.size(); }
+};
+// 可删除、可随机取元素的整数集合：元素紧密存放在数组里，开放寻址的哈希表记录每个元素的下标
+// 插入、删除、等概率随机取一个元素都是O(1)
+class EdgeSet {
+   private:
+    static constexpr unsigned long long EMPTY = ~0ULL;      // 空位标记
+    std::vector<std::pair<unsigned long long, int>> table;  // (元素,在item中的下标)
+    std::vector<unsigned long long> item;                   // 所有元素
+    unsigned long long mask;
+    // 元素x所在的槽，不存在时为它应该放的空槽
+    unsigned long long Slot(unsigned long long x) const {
+        unsigned long long i = HashSet::Hash(x) & mask;
+        while (table[i].first != EMPTY && table[i].first != x) {
+            i = (i + 1) & mask;
         }
+        return i;
     }
 
    public:
     /**
-     * 默认为无根树
-     * @param n 结点数
-     * @param is_rt 是否有根
-     * @param rt 根,默认为0,范围应为[begin_node,n-1+begin_node],只在is_root=true时生效
+     * @param n 同时存在的元素个数的上限
      */
-    Tree(int n = 1, bool is_rt = 0, int rt = 0) {
-        node = n;
-        is_root = is_rt;
-        root = rt;
-    }
+    EdgeSet(size_t n = 0) { Reset(n); }
     /**
-     * 设置结点数
-     * @param n 结点数
+     * 清空集合并按元素个数的上限重新分配空间
+     * @param n 同时存在的元素个数的上限
      */
-    void SetNode(int n) { node = n; }
+    void Reset(size_t n) {
+        size_t cap = 16;
+        while (cap < 2 * n) {
+            cap <<= 1;
+        }
+        table.assign(cap, {EMPTY, 0});
+        mask = cap - 1;
+        item.clear();
+        item.reserve(n);
+    }
     /**
-     * 设置无根/有根树,如果是有根树的话，边为(father,son);否则边为(father,son)与(son,father)中的任意一个
-     * @param is_rt 是否有根
+     * 插入元素
+     * @return 元素原来是否不存在
+     * @attention 元素不能为~0ULL
      */
-    void SetIsRoot(bool is_rt) { is_root = is_rt; }
+    bool Insert(unsigned long long x) {
+        unsigned long long i = Slot(x);
+        if (table[i].first == x) {
+            return false;
+        }
+        table[i] = {x, (int)item.size()};
+        item.push_back(x);
+        return true;
+    }
     /**
-     * 设置根，只在有根树的时候生效
-     * @param rt 根,范围应为[0,n-1]
+     * 查询元素是否存在
      */
-    void SetRoot(int rt) { root = rt; }
+    bool Count(unsigned long long x) const { return table[Slot(x)].first == x; }
     /**
-     * 获取根，只在有根的时候有效
-     * @return 根
+     * 删除元素：数组的最后一个元素移到它的位置，哈希表中后面的元素前移填补空位
+     * @return 元素是否存在
      */
-    int GetRoot() {
-        if (is_root) {
-            return root + begin_node;
+    bool Erase(unsigned long long x) {
+        unsigned long long i = Slot(x);
+        if (table[i].first != x) {
+            return false;
         }
-        FailGen("Unroot Tree,but ask for get root.\n");
-        return 0;
+        int pos = table[i].second;
+        unsigned long long last = item.back();
+        item[pos] = last;
+        table[Slot(last)].second = pos;
+        item.pop_back();
+        unsigned long long j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (table[j].first == EMPTY) {
+                break;
+            }
+            unsigned long long k = HashSet::Hash(table[j].first) & mask;
+            // k不在(i,j]之间时，table[j]可以移到i
+            if ((i < j) ? (k <= i || k > j) : (k <= i && k > j)) {
+                table[i] = table[j];
+                i = j;
+            }
+        }
+        table[i].first = EMPTY;
+        return true;
     }
     /**
-     * 获取边
-     * @return 边
+     * 等概率随机取一个元素，集合不能为空
      */
-    std::vector<std::pair<int, int>> GetEdge() { return edge; }
+    unsigned long long Random() const { return item[thread_rnd->next((int)item.size())]; }
+    size_t Size() const { return item.size(); }
+};
+// 别名表，O(n)建表后每次O(1)按权重抽样
+class AliasTable {
+   private:
+    std::vector<double> prob;
+    std::vector<int> alias;
+
+   public:
     /**
-     * 设置点数上限
+     * @param w 每个下标的权重，不能全为0
      */
-    void SetNodeLimit(unsigned int n) {
-        node_limit = n;
-    }
+    AliasTable(const std::vector<double>& w = {}) { Build(w); }
     /**
-     * 设置边数上限
+     * 按权重重新建表
+     * @param w 每个下标的权重，不能全为0
      */
-    void SetEdgeLimit(unsigned int m) {
-        edge_limit = m;
+    void Build(const std::vector<double>& w) {
+        int n = w.size();
+        prob.resize(n);
+        alias.resize(n);
+        double sum = 0;
+        for (double x : w) {
+            sum += x;
+        }
+        std::vector<int> small, large;
+        for (int i = 0; i < n; i++) {
+            prob[i] = w[i] * n / sum;
+            alias[i] = i;
+            if (prob[i] < 1) {
+                small.push_back(i);
+            } else {
+                large.push_back(i);
+            }
+        }
+        while (!small.empty() && !large.empty()) {
+            int s = small.back(), l = large.back();
+            small.pop_back();
+            alias[s] = l;
+            prob[l] -= 1 - prob[s];
+            if (prob[l] < 1) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // 剩下的由浮点误差造成，概率视为1
+        for (int i : small) {
+            prob[i] = 1;
+        }
+        for (int i : large) {
+            prob[i] = 1;
+        }
     }
     /**
-     * 设置第一个结点的编号
+     * 按权重随机一个下标
      */
-    void SetBeginNode(int n) {
-        begin_node = n;
+    int Next() {
+        int i = thread_rnd->next((int)prob.size());
+        return thread_rnd->next() < prob[i] ? i : alias[i];
     }
-    /**
-     * 生成树
-     */
-    void GenTree() {
-        Init();
-        for (int i = 1; i < node; i++) {
-            int f = rnd.next(i);
-            AddEdge(p[f], p[i]);
+};
+/**
+ * 到目前为止的堆分配次数，没有定义GRAPHGEN_COUNT_ALLOC时为-1
+ */
+long long AllocCount() {
+#ifdef GRAPHGEN_COUNT_ALLOC
+    return alloc_count;
+#else
+    return -1;
+#endif
+}
+/**
+ * 把p变成0~n-1的随机排列，结果和rnd.perm(n,0)相同，p的空间足够时不重新分配
+ */
+void RandPerm(std::vector<int>& p, int n) {
+    p.resize(n);
+    for (int i = 0; i < n; i++) {
+        p[i] = i;
+    }
+    for (int i = 1; i < n; i++) {
+        std::swap(p[i], p[thread_rnd->next(i + 1)]);
+    }
+}
+/**
+ * 默认的线程数
+ */
+int DefaultThread() { return std::max(1u, std::thread::hardware_concurrency()); }
+/**
+ * 用thread个线程并行执行f(0),f(1),...,f(n-1)，每个线程执行完一个任务后领取下一个
+ * @note 任务之间不能有依赖，结果不能依赖执行顺序
+ */
+template <typename F>
+void ParallelFor(int n, int thread, F f) {
+    thread = std::max(1, std::min(thread, n));
+    if (thread == 1) {
+        for (int i = 0; i < n; i++) {
+            f(i);
         }
-        shuffle(edge.begin(), edge.end());
+        return;
     }
-};
-// 一条链，默认为无根树
-class Chain : public Tree {
+    std::atomic<int> next(0);
+    std::vector<std::thread> worker;
+    for (int t = 0; t < thread; t++) {
+        worker.emplace_back([&]() {
+            for (int i; (i = next++) < n;) {
+                f(i);
+            }
+        });
+    }
+    for (auto& w : worker) {
+        w.join();
+    }
+}
+/**
+ * 并行排序，分块排序后两两归并
+ * @param a 待排序的数组
+ * @param thread 线程数
+ */
+template <typename T>
+void ParallelSort(std::vector<T>& a, int thread) {
+    size_t n = a.size();
+    int part = std::max(1, std::min<int>(thread, n / 65536));
+    std::vector<size_t> bound(part + 1);
+    for (int i = 0; i <= part; i++) {
+        bound[i] = n * i / part;
+    }
+    ParallelFor(part, thread, [&](int i) { std::sort(a.begin() + bound[i], a.begin() + bound[i + 1]); });
+    std::vector<T> tmp(part > 1 ? n : 0);
+    for (int width = 1; width < part; width *= 2) {
+        int group = (part + 2 * width - 1) / (2 * width);
+        ParallelFor(group, thread, [&](int g) {
+            size_t l = bound[2 * g * width];
+            size_t mid = bound[std::min(part, (2 * g + 1) * width)];
+            size_t r = bound[std::min(part, (2 * g + 2) * width)];
+            std::merge(a.begin() + l, a.begin() + mid, a.begin() + mid, a.begin() + r, tmp.begin() + l);
+        });
+        a.swap(tmp);
+    }
+}
+/**
+ * 对非负整数进行基数排序，只处理max实际用到的位
+ * @param a 待排序的数组
+ * @param max a中元素的上界
+ */
+void RadixSort(std::vector<unsigned long long>& a, unsigned long long max) {
+    std::vector<unsigned long long> tmp(a.size());
+    std::vector<size_t> cnt(1 << 16);
+    for (int shift = 0; shift < 64 && (max >> shift) > 0; shift += 16) {
+        std::fill(cnt.begin(), cnt.end(), 0);
+        for (unsigned long long x : a) {
+            cnt[(x >> shift) & 0xffff]++;
+        }
+        size_t sum = 0;
+        for (size_t& c : cnt) {
+            size_t t = c;
+            c = sum;
+            sum += t;
+        }
+        for (unsigned long long x : a) {
+            tmp[cnt[(x >> shift) & 0xffff]++] = x;
+        }
+        a.swap(tmp);
+    }
+}
+/**
+ * 从[0,total)中无放回地均匀选出k个数(Floyd算法,每个数只抽一次随机数,不做拒绝)
+ * @param total 总数
+ * @param k 选出的个数
+ * @return 升序排列的k个数
+ */
+std::vector<unsigned long long> SampleSorted(unsigned long long total, unsigned long long k) {
+    std::vector<unsigned long long> res;
+    if (k > total) {
+        FailGen("can not choose %llu numbers from %llu numbers.\n", k, total);
+    }
+    // 选的数超过一半时改为选出补集
+    bool complement = k > total / 2;
+    unsigned long long need = complement ? total - k : k;
+    HashSet chosen(need);
+    res.reserve(need);
+    for (unsigned long long j = total - need; j < total; j++) {
+        unsigned long long t = thread_rnd->next((long long)j + 1);
+        if (!chosen.Insert(t)) {
+            chosen.Insert(j);
+            t = j;
+        }
+        res.push_back(t);
+    }
+    RadixSort(res, total);
+    if (complement) {
+        std::vector<unsigned long long> all;
+        all.reserve(k);
+        size_t pos = 0;
+        for (unsigned long long x = 0; x < total; x++) {
+            if (pos < res.size() && res[pos] == x) {
+                pos++;
+            } else {
+                all.push_back(x);
+            }
+        }
+        res.swap(all);
+    }
+    return res;
+}
+/**
+ * 按(first,second)对点对做两趟计数排序
+ * @param a 点对，两个值都在[0,n)中
+ */
+void SortPair(std::vector<std::pair<int, int>>& a, int n) {
+    std::vector<int> cnt(n + 1);
+    std::vector<std::pair<int, int>> tmp(a.size());
+    for (int pass = 0; pass < 2; pass++) {
+        std::fill(cnt.begin(), cnt.end(), 0);
+        for (auto x : a) {
+            cnt[(pass ? x.first : x.second) + 1]++;
+        }
+        for (int i = 0; i < n; i++) {
+            cnt[i + 1] += cnt[i];
+        }
+        for (auto x : a) {
+            tmp[cnt[pass ? x.first : x.second]++] = x;
+        }
+        a.swap(tmp);
+    }
+}
+/**
+ * 每个点u可以连向[low[u],high[u])中的点，去掉ban中的点对后，无放回地均匀选出k个点对
+ * @param low 每个点可选终点区间的左端点
+ * @param high 每个点可选终点区间的右端点(不含)
+ * @param ban 不能选的点对，按(u,v)升序排列，且v在u的可选区间中
+ * @return 选出的点对，按(u,v)升序排列
+ */
+std::vector<std::pair<int, int>> SampleRange(const std::vector<int>& low, const std::vector<int>& high,
+                                             const std::vector<std::pair<int, int>>& ban,
+                                             unsigned long long k) {
+    int n = low.size();
+    unsigned long long total = 0;
+    for (int u = 0; u < n; u++) {
+        total += high[u] - low[u];
+    }
+    std::vector<unsigned long long> pick = SampleSorted(total - ban.size(), k);
+    std::vector<std::pair<int, int>> res;
+    res.reserve(k);
+    size_t s = 0, q = 0;
+    unsigned long long before = 0;
+    for (int u = 0; u < n && q < pick.size(); u++) {
+        while (s < ban.size() && ban[s].first < u) {
+            s++;
+        }
+        size_t t = s;
+        while (t < ban.size() && ban[t].first == u) {
+            t++;
+        }
+        // 第r个可选的点是low[u]+r，再跳过不超过它的被禁止的点
+        unsigned long long free = high[u] - low[u] - (t - s);
+        int v = low[u] - 1;
+        unsigned long long last = before;
+        while (q < pick.size() && pick[q] < before + free) {
+            v += pick[q] - last + 1;
+            last = pick[q] + 1;
+            while (s < t && ban[s].second <= v) {
+                s++;
+                v++;
+            }
+            res.push_back({u, v});
+            q++;
+        }
+        before += free;
+        s = t;
+    }
+    return res;
+}
+/**
+ * 基本结构的构造器，把链、环、菊花、树、完全图、网格的边直接追加到调用者给出的边集中
+ * @note 结构建立在调用者给出的点集a的区间[l,r)上，r=-1表示到a的末尾
+ * @note 输出的点编号为a中的值加上begin_node；无向时每条边随机一个方向
+ * @note 不做任何去重，调用者要保证点集中没有重复点
+ */
+class Builder {
+   private:
+    std::vector<std::pair<int, int>>& edge;  // 调用者的边集
+    int begin_node;                         // 结点开始编号
+    bool direction;                         // 是否有向
+    int End(const std::vector<int>& a, int r) { return r == -1 ? (int)a.size() : r; }
+    // a[l..r)中的点依次挂到a[lo..i)中随机一个点上
+    void Attach(const std::vector<int>& a, int lo, int l, int r, bool to_father) {
+        for (int i = l; i < r; i++) {
+            int f = a[thread_rnd->next(lo, i - 1)];
+            if (to_father) {
+                Edge(a[i], f);
+            } else {
+                Edge(f, a[i]);
+            }
+        }
+    }
+
    public:
     /**
-     * 一条链，默认为无根树
-     * @param n 结点数
-     * @param is_rt 是否有根
-     * @param rt 根,默认为0,范围应为[0,n-1],只在is_root=true时生效
+     * @param e 边集，新边追加到末尾
+     * @param b 结点开始编号
+     * @param d 是否有向
      */
-    Chain(int n = 1, bool is_rt = 0, int rt = 0) {
-        node = n;
-        is_root = is_rt;
-        root = rt;
-    }
+    Builder(std::vector<std::pair<int, int>>& e, int b = 1, bool d = 0)
+        : edge(e), begin_node(b), direction(d) {}
     /**
-     * 生成树
+     * 预留空间
+     * @param m 将要追加的边数
      */
-    void GenTree() {
-        Init();
-        for (int i = 1; i < node; i++) {
-            AddEdge(p[i - 1], p[i]);
+    void Reserve(size_t m) { edge.reserve(edge.size() + m); }
+    /**
+     * 加一条边，有向时为u->v
+     */
+    void Edge(int u, int v) {
+        u += begin_node;
+        v += begin_node;
+        if (direction || thread_rnd->next(2)) {
+            edge.push_back({u, v});
+        } else {
+            edge.push_back({v, u});
         }
-        shuffle(edge.begin(), edge.end());
     }
-};
-// 一个菊花图，默认为无根树
-class Flower : public Tree {
-   public:
     /**
-     * 一个菊花图，默认为无根树
-     * @param n 结点数
-     * @param is_rt 是否有根
-     * @param rt 根,默认为0,范围应为[0,n-1],只在is_root=true时生效
+     * 链a[l]-a[l+1]-...-a[r-1]，有向时从后往前
      */
-    Flower(int n = 1, bool is_rt = 0, int rt = 0) {
-        node = n;
-        is_root = is_rt;
-        root = rt;
+    void Path(const std::vector<int>& a, int l = 0, int r = -1) {
+        r = End(a, r);
+        for (int i = l + 1; i < r; i++) {
+            Edge(a[i], a[i - 1]);
+        }
     }
     /**
-     * 生成树
+     * 环，有向时为a[i]->a[i-1]以及a[l]->a[r-1]
+     * @note 无向时少于3个点不成环，有向时少于2个点不成环
      */
-    void GenTree() {
-        Init();
-        for (int i = 1; i < node; i++) {
-            AddEdge(p[0], p[i]);
+    void Cycle(const std::vector<int>& a, int l = 0, int r = -1) {
+        r = End(a, r);
+        Path(a, l, r);
+        if (r - l >= 3 || (direction && r - l == 2)) {
+            Edge(a[l], a[r - 1]);
         }
-        shuffle(edge.begin(), edge.end());
     }
-};
-// 一颗限制高度的树，必须有根
-class HeightTree : public Tree {
-   private:
-    int height;       // 树的高度
-    bool set_height;  // 判断是否设置树高
-   public:
     /**
-     * 一个限制高度的树
-     * @param n 结点数
-     * @param is_rt 是否有根，必须有根
-     * @param h 树高度,不指定的话在生成的时候随机高度
-     * @param rt 根,默认为0,范围应为[0,n-1],只在is_root=true时生效
+     * 以c为中心的菊花，有向时为c->a[i]
      */
-    HeightTree(int n = 1, int h = -1, int rt = 0) {
-        node = n;
-        is_root = 1;
-        root = rt;
-        if (h != -1) {
-            SetHeight(h);
+    void Star(int c, const std::vector<int>& a, int l = 0, int r = -1) {
+        r = End(a, r);
+        for (int i = l; i < r; i++) {
+            Edge(c, a[i]);
         }
     }
     /**
-     * 设置树的高度
-     * @param h 树高
+     * 以a[l]为根的随机树，a[l+1..r)中的点依次挂到区间中前面的随机一个点上
+     * @param to_father 有向时边的方向，false为(father,son)，true为(son,father)
      */
-    void SetHeight(int h) {
-        height = h;
-        set_height = 1;
+    void Tree(const std::vector<int>& a, int l = 0, int r = -1, bool to_father = false) {
+        r = End(a, r);
+        Attach(a, l, l + 1, r, to_father);
     }
     /**
-     * 设置树的高度为随机生成
+     * 在已有的点a[0..l)上长出树，a[l..r)中的点依次挂到前面的随机一个点上
+     * @param to_father 有向时边的方向，false为(father,son)，true为(son,father)
      */
-    void ResetHeight() { set_height = 0; }
+    void Grow(const std::vector<int>& a, int l, int r = -1, bool to_father = false) {
+        r = End(a, r);
+        Attach(a, 0, std::max(l, 1), r, to_father);
+    }
     /**
-     * 强制为有根树，函数不可调用
-     * @param is_rt 是否有根
+     * 完全图，有向时每对点两个方向都连边
      */
-    void SetIsRoot(bool is_rt) = delete;
+    void Clique(const std::vector<int>& a, int l = 0, int r = -1) {
+        r = End(a, r);
+        for (int i = l; i < r; i++) {
+            for (int j = i + 1; j < r; j++) {
+                Edge(a[i], a[j]);
+                if (direction) {
+                    Edge(a[j], a[i]);
+                }
+            }
+        }
+    }
     /**
-     * 生成树
+     * 网格，a[l+i*column+j]为第i行第j列的点，最后一行可以不满
+     * @param column 列数
      */
-    void GenTree() {
-        if (!set_height) {
-            SetHeight(rnd.next(node == 1 ? 1 : 2, node));
+    void Grid(const std::vector<int>& a, int column, int l = 0, int r = -1) {
+        r = End(a, r);
+        for (int x = 0; x < r - l; x++) {
+            if (x % column != 0) {
+                Edge(a[l + x - 1], a[l + x]);
+            }
+            if (x >= column) {
+                Edge(a[l + x - column], a[l + x]);
+            }
         }
-        if (height > node) {
-            FailGen("restriction of the height is [%d,%d].\n", node == 1 ? 1 : 2, node);
+    }
+};
+
+// 带缓冲的快速输出，不指定文件时全部保存在内存里
+/**
+ * 整数x的十进制表示的字节数，包括负号
+ */
+int IntLength(long long x) {
+    unsigned long long y = x < 0 ? 0 - (unsigned long long)x : x;
+    int k = 1;
+    // 只比较不做除法，10^19之后不再乘，避免溢出
+    for (unsigned long long p = 10; k < 20 && y >= p; p *= 10) {
+        k++;
+    }
+    return k + (x < 0);
+}
+/**
+ * 把x的十进制表示写到p开始的位置
+ * @return 写完之后的位置
+ */
+char* FormatInt(char* p, long long x) {
+    char* end = p + IntLength(x);
+    unsigned long long y = x;
+    if (x < 0) {
+        *p = '-';
+        y = 0 - y;
+    }
+    char* q = end;
+    do {
+        *--q = '0' + y % 10;
+        y /= 10;
+    } while (y);
+    return end;
+}
+class Writer {
+   private:
+    FILE* file;
+    std::vector<char> buf;
+    size_t pos = 0;
+    void Reserve(size_t k) {
+        if (pos + k <= buf.size()) {
+            return;
         }
-        if ((node > 1 && height <= 1) || height < 1) {
-            FailGen("restriction of the height is [%d,%d].\n", node == 1 ? 1 : 2, node);
+        if (file) {
+            Flush();
+        } else {
+            buf.resize(std::max(buf.size() * 2, pos + k));
         }
-        Init();
-        std::vector<int> number(height, 1);
-        int w = node - height;
-        for (int i = 1; i <= w; i++) {
-            number[rnd.next(1, height - 1)]++;
+    }
+
+   public:
+    /**
+     * @param f 输出文件，为nullptr时只写入内存
+     * @param size 缓冲区大小
+     */
+    Writer(FILE* f = stdout, size_t size = 1 << 16) : file(f), buf(std::max<size_t>(size, 64)) {}
+    ~Writer() { Flush(); }
+    /**
+     * 把缓冲区写入文件，只写入内存时什么都不做
+     */
+    void Flush() {
+        if (file) {
+            fwrite(buf.data(), 1, pos, file);
+            pos = 0;
         }
-        int l = 0, r = 0, k = 0;
-        for (int i = 1; i < node; i++) {
-            if (r + number[k] == i) {
-                l = r;
-                r += number[k];
-                k++;
+    }
+    /**
+     * 已经写入内存的字节数
+     */
+    size_t Size() const { return pos; }
+    /**
+     * 已经写入内存的内容
+     */
+    const char* Data() const { return buf.data(); }
+    /**
+     * 丢弃第k个字节之后的内容，只写入内存时用于撤销
+     */
+    void Resize(size_t k) { pos = std::min(pos, k); }
+    void WriteChar(char c) {
+        Reserve(1);
+        buf[pos++] = c;
+    }
+    void WriteString(const std::string& s) {
+        Reserve(s.size());
+        // 有文件时Reserve只会清空缓冲区，比缓冲区还长的串直接写入文件
+        if (pos + s.size() > buf.size()) {
+            fwrite(s.data(), 1, s.size(), file);
+            return;
+        }
+        std::copy(s.begin(), s.end(), buf.begin() + pos);
+        pos += s.size();
+    }
+    /**
+     * 输出一行，整数之间用空格隔开
+     */
+    void WriteLine(std::initializer_list<long long> a) {
+        bool first = true;
+        for (long long x : a) {
+            if (!first) {
+                WriteChar(' ');
             }
-            int f = rnd.next(l, r - 1);
-            AddEdge(p[f], p[i]);
+            WriteInt(x);
+            first = false;
         }
-        shuffle(edge.begin(), edge.end());
+        WriteChar('\n');
+    }
+    void WriteInt(long long x) {
+        Reserve(24);
+        pos = FormatInt(buf.data() + pos, x) - buf.data();
     }
 };
-// 普通图
-class Graph {
+// 线性时间检查生成结果的性质，用于调试模式和对大数据的校验
+class Verifier {
+   private:
+    int node;                                       // 结点数
+    int begin_node;                                 // 结点开始编号
+    bool direction;                                 // 是否为有向图
+    const std::vector<std::pair<int, int>>& edge;  // 要检查的边，端点已经加上begin_node
+    std::vector<int> start;                         // 邻接表(CSR)：adj[start[u]]~adj[start[u+1]-1]为u的出边
+    std::vector<std::pair<int, int>> adj;           // (终点,边的编号)
+    std::vector<int> dsu, dsu_size;                 // 并查集，按大小合并
+    void InitDsu(int n) {
+        dsu.resize(n);
+        dsu_size.assign(n, 1);
+        for (int i = 0; i < n; i++) {
+            dsu[i] = i;
+        }
+    }
+    int Find(int x) {
+        while (dsu[x] != x) {
+            x = dsu[x] = dsu[dsu[x]];
+        }
+        return x;
+    }
+    bool Union(int x, int y) {
+        x = Find(x);
+        y = Find(y);
+        if (x == y) {
+            return false;
+        }
+        if (dsu_size[x] > dsu_size[y]) {
+            std::swap(x, y);
+        }
+        dsu[x] = y;
+        dsu_size[y] += dsu_size[x];
+        return true;
+    }
+    /**
+     * 建立邻接表
+     * @param both 是否把每条边同时作为两个端点的出边，无向图的检查需要
+     */
+    void BuildAdj(bool both) {
+        start.assign(node + 1, 0);
+        for (auto [u, v] : edge) {
+            start[u - begin_node + 1]++;
+            if (both) {
+                start[v - begin_node + 1]++;
+            }
+        }
+        for (int i = 0; i < node; i++) {
+            start[i + 1] += start[i];
+        }
+        adj.resize(start[node]);
+        std::vector<int> pos(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < edge.size(); i++) {
+            int u = edge[i].first - begin_node, v = edge[i].second - begin_node;
+            adj[pos[u]++] = {v, i};
+            if (both) {
+                adj[pos[v]++] = {u, i};
+            }
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param e 边，端点范围为[b,b+n-1]
+     * @param b 结点开始编号
+     * @param d 是否为有向图
+     * @attention 只保存e的引用，检查期间e不能改变
+     */
+    Verifier(int n, const std::vector<std::pair<int, int>>& e, int b = 1, bool d = false)
+        : node(n), begin_node(b), direction(d), edge(e) {}
+    /**
+     * 所有端点都在[begin_node,begin_node+n-1]内，其余检查都以此为前提
+     */
+    bool InRange() {
+        for (auto [u, v] : edge) {
+            if (u < begin_node || u >= begin_node + node || v < begin_node || v >= begin_node + node) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * 没有自环
+     */
+    bool NoSelfLoop() {
+        for (auto [u, v] : edge) {
+            if (u == v) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * 没有重边，无向图中(u,v)和(v,u)算作重边，把边编码后基数排序再比较相邻元素
+     */
+    bool NoMultiplyEdge() {
+        std::vector<unsigned long long> key(edge.size());
+        for (size_t i = 0; i < edge.size(); i++) {
+            unsigned long long u = edge[i].first - begin_node, v = edge[i].second - begin_node;
+            if (!direction && u > v) {
+                std::swap(u, v);
+            }
+            key[i] = u * node + v;
+        }
+        RadixSort(key, (unsigned long long)node * node);
+        for (size_t i = 1; i < key.size(); i++) {
+            if (key[i] == key[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * 连通，有向图检查弱连通
+     */
+    bool Connected() {
+        InitDsu(node);
+        int component = node;
+        for (auto [u, v] : edge) {
+            if (component <= 1) {
+                break;
+            }
+            component -= Union(u - begin_node, v - begin_node);
+        }
+        return component <= 1;
+    }
+    /**
+     * 连通分量个数，有向图为弱连通分量
+     */
+    int Components() {
+        InitDsu(node);
+        int component = node;
+        for (auto [u, v] : edge) {
+            component -= Union(u - begin_node, v - begin_node);
+        }
+        return component;
+    }
+    /**
+     * 是二分图，忽略边的方向：u和v+n合并、u+n和v合并，u和u+n在同一集合时有奇环
+     */
+    bool Bipartite() {
+        InitDsu(2 * node);
+        for (auto [u, v] : edge) {
+            u -= begin_node;
+            v -= begin_node;
+            Union(u, v + node);
+            Union(u + node, v);
+            if (Find(u) == Find(u + node)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * 有向图无环，拓扑排序能取出所有点
+     */
+    bool Acyclic() {
+        BuildAdj(false);
+        std::vector<int> in(node, 0), queue;
+        queue.reserve(node);
+        for (auto [v, e] : adj) {
+            in[v]++;
+        }
+        for (int i = 0; i < node; i++) {
+            if (in[i] == 0) {
+                queue.push_back(i);
+            }
+        }
+        for (size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            for (int j = start[u]; j < start[u + 1]; j++) {
+                if (--in[adj[j].first] == 0) {
+                    queue.push_back(adj[j].first);
+                }
+            }
+        }
+        return (int)queue.size() == node;
+    }
+    /**
+     * 是边仙人掌，即每条边最多在一个简单环上，忽略边的方向
+     * @note 非递归DFS，每条返祖边把树上路径的边标记一遍，某条树边被标记两次就不是仙人掌
+     */
+    bool Cactus() {
+        BuildAdj(true);
+        // 同一个点的DFS状态放在一起，减少随机访问；mark：到父亲的树边已经在某个环上
+        struct State {
+            int depth = -1, father, father_edge, cur;
+            bool mark = false;
+        };
+        std::vector<State> a(node);
+        std::vector<int> stack;
+        for (int s = 0; s < node; s++) {
+            if (a[s].depth != -1) {
+                continue;
+            }
+            a[s].depth = 0;
+            a[s].father_edge = -1;
+            a[s].cur = start[s];
+            stack.push_back(s);
+            while (!stack.empty()) {
+                int u = stack.back();
+                State& x = a[u];
+                if (x.cur == start[u + 1]) {
+                    stack.pop_back();
+                    continue;
+                }
+                auto [v, e] = adj[x.cur++];
+                if (e == x.father_edge) {
+                    continue;
+                }
+                State& y = a[v];
+                if (y.depth == -1) {
+                    y.depth = x.depth + 1;
+                    y.father = u;
+                    y.father_edge = e;
+                    y.cur = start[v];
+                    stack.push_back(v);
+                } else if (y.depth < x.depth) {
+                    for (int w = u; w != v; w = a[w].father) {
+                        if (a[w].mark) {
+                            return false;
+                        }
+                        a[w].mark = true;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    /**
+     * 每个点的出度(reverse=true时为入度)都恰好为1，即内向(外向)基环树森林
+     */
+    bool Functional(bool reverse = false) {
+        std::vector<int> degree(node, 0);
+        for (auto [u, v] : edge) {
+            if (++degree[(reverse ? v : u) - begin_node] > 1) {
+                return false;
+            }
+        }
+        return (int)edge.size() == node;
+    }
+    /**
+     * 是以root为根的外向树，即除root外每个点入度恰好为1，root入度为0，且连通
+     */
+    bool Rooted(int root) {
+        std::vector<int> in(node, 0);
+        for (auto [u, v] : edge) {
+            in[v - begin_node]++;
+        }
+        for (int i = 0; i < node; i++) {
+            if (in[i] != (i != root - begin_node)) {
+                return false;
+            }
+        }
+        return Connected();
+    }
+    /**
+     * 忽略边的方向，从root开始BFS能到达的层数，root自己为第1层
+     */
+    int Height(int root) {
+        BuildAdj(true);
+        std::vector<int> depth(node, 0), queue = {root - begin_node};
+        depth[root - begin_node] = 1;
+        int res = 1;
+        for (size_t i = 0; i < queue.size(); i++) {
+            int u = queue[i];
+            res = std::max(res, depth[u]);
+            for (int j = start[u]; j < start[u + 1]; j++) {
+                int v = adj[j].first;
+                if (depth[v] == 0) {
+                    depth[v] = depth[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        return res;
+    }
+};
+// 生成过程中计时的阶段
+enum Phase {
+    PHASE_VALIDATE,  // 检查参数，清空边集
+    PHASE_PERM,      // 生成随机排列
+    PHASE_TREE,      // 保证连通的生成树或骨架
+    PHASE_RANDOM,    // 随机加边，包括被拒绝的尝试
+    PHASE_SHUFFLE,   // 生成边权并打乱边
+    PHASE_OUTPUT,    // 输出
+    PHASE_COUNT
+};
+const char* phase_name[PHASE_COUNT] = {"validate", "permutation", "tree", "random", "shuffle", "output"};
+/**
+ * 最近一次生成的统计，只在定义了GRAPHGEN_STATS时记录，否则全为0
+ * @note 目前记录的是Graph,BipartiteGraph,DAG,GridGraph的GenGraph和所有类的Output
+ */
+struct Stats {
+    long long attempt = 0;             // 随机加边时抽取点对的次数
+    long long reject = 0;              // 因为自环、重边或越界被拒绝的次数
+    size_t set_size = 0;               // 生成结束时去重表的元素个数
+    size_t set_capacity = 0;           // 去重表的槽数
+    double time[PHASE_COUNT] = {0};    // 每个阶段的耗时(秒)
+    /**
+     * 接受率，没有尝试时为1
+     */
+    double AcceptRate() const { return attempt ? 1.0 * (attempt - reject) / attempt : 1; }
+    /**
+     * 以可读的形式输出
+     */
+    void Print(FILE* out = stderr) const {
+        fprintf(out, "attempt=%lld reject=%lld accept_rate=%.4f set_size=%zu set_capacity=%zu\n", attempt, reject,
+                AcceptRate(), set_size, set_capacity);
+        for (int i = 0; i < PHASE_COUNT; i++) {
+            fprintf(out, "%s=%.6fs%c", phase_name[i], time[i], i + 1 == PHASE_COUNT ? '\n' : ' ');
+        }
+    }
+};
+// 边集和边权，树和图的公共部分
+class EdgeList {
    protected:
-    unsigned int node_limit = 1e6;          // 结点数的上限
-    unsigned int edge_limit = 1e6;          // 边数的上限
-    int begin_node = 1;                     // 结点开始编号
-    int node, side;                         // 点数，边数
+    Stats stats;              // 最近一次生成的统计
+    double warn_rate = 0.1;   // 接受率低于它时在stderr输出警告
+    int stat_phase = -1;      // 正在计时的阶段，-1表示没有在计时
+#ifdef GRAPHGEN_STATS
+    std::chrono::steady_clock::time_point stat_mark;  // 当前阶段开始的时间
+#endif
+    /**
+     * 结束当前阶段的计时并开始阶段x，x=-1时只结束计时；没有定义GRAPHGEN_STATS时什么都不做
+     */
+    void StatPhase([[maybe_unused]] int x) {
+#ifdef GRAPHGEN_STATS
+        auto now = std::chrono::steady_clock::now();
+        if (stat_phase != -1) {
+            stats.time[stat_phase] += std::chrono::duration<double>(now - stat_mark).count();
+        }
+        stat_phase = x;
+        stat_mark = now;
+#endif
+    }
+    /**
+     * 生成开始时清空统计，开始检查参数阶段
+     */
+    void StatBegin() {
+#ifdef GRAPHGEN_STATS
+        stats = Stats();
+        stat_phase = -1;
+        StatPhase(PHASE_VALIDATE);
+#endif
+    }
+    /**
+     * 生成结束时停止计时，记录去重表大小，接受率过低时警告
+     */
+    void StatEnd([[maybe_unused]] const HashSet* set = nullptr) {
+#ifdef GRAPHGEN_STATS
+        StatPhase(-1);
+        if (set) {
+            stats.set_size = set->Size();
+            stats.set_capacity = set->Capacity();
+        }
+        if (stats.AcceptRate() < warn_rate) {
+            fprintf(stderr, "warning: acceptance rate %.4f (%lld of %lld attempts rejected) is below %.4f.\n",
+                    stats.AcceptRate(), stats.reject, stats.attempt, warn_rate);
+        }
+#endif
+    }
+    /**
+     * 统计一次随机加边的尝试
+     * @param r 这次尝试是否被拒绝
+     * @return r，用在拒绝采样的循环条件里
+     */
+    bool StatReject(bool r) {
+#ifdef GRAPHGEN_STATS
+        stats.attempt++;
+        stats.reject += r;
+#endif
+        return r;
+    }
     std::vector<std::pair<int, int>> edge;  // 边
-    std::map<std::pair<int, int>, bool> e;  // 边的去重
+    std::vector<long long> weight;          // 边权，weight[i]为edge[i]的边权，没有边权时为空
     /**
-     *0：无向
-     *1：有向
-     *默认无向图
+     *0：没有边权
+     *1：[weight_min,weight_max]内均匀随机
+     *2：weight_min加上参数为weight_p的几何分布
+     *3：自定义函数
+     *默认没有边权
      */
-    bool direction;
+    int weight_type = 0;
+    long long weight_min, weight_max;
+    double weight_p;
+    std::function<long long(int, int)> weight_func;
     /**
-     *0：无重边
-     *1：有重边
-     *默认无重边
+     * 按设置的分布批量生成边权
+     * @param from 保留前from条边的边权，只生成之后的边的边权
      */
-    bool multiply_edge;
+    void GenWeight(size_t from = 0) {
+        weight.resize(from);
+        if (weight_type == 0) {
+            return;
+        }
+        size_t m = edge.size();
+        weight.resize(m);
+        if (weight_type == 1) {
+            for (size_t i = from; i < m; i++) {
+                weight[i] = thread_rnd->next(weight_min, weight_max);
+            }
+        } else if (weight_type == 2) {
+            double q = weight_p < 1 ? 1 / std::log(1 - weight_p) : 0;
+            for (size_t i = from; i < m; i++) {
+                weight[i] = weight_min + (long long)(std::log(1 - thread_rnd->next()) * q);
+            }
+        } else {
+            for (size_t i = from; i < m; i++) {
+                weight[i] = weight_func(edge[i].first, edge[i].second);
+            }
+        }
+    }
     /**
-     *0：无自环
-     *1：有自环
-     *默认无自环
+     * 按设置的分布生成一条边的边权，和GenWeight的分布相同，没有设置边权时为0
+     * @param u,v 边的两个端点(已经加上begin_node)
      */
-    bool self_loop;
+    long long RandWeight(int u, int v) {
+        if (weight_type == 1) {
+            return thread_rnd->next(weight_min, weight_max);
+        } else if (weight_type == 2) {
+            double q = weight_p < 1 ? 1 / std::log(1 - weight_p) : 0;
+            return weight_min + (long long)(std::log(1 - thread_rnd->next()) * q);
+        } else if (weight_type == 3) {
+            return weight_func(u, v);
+        }
+        return 0;
+    }
     /**
-     *0：不保证连通
-     *1：保证连通
-     *默认不保证连通
+     * 生成器的最后一步：生成边权，然后打乱边，边权跟着边一起移动
+     * @param keep_weight 生成器已经给出了和边对应的边权，不再按分布生成
      */
-    bool connect;
-    bool JudgeSelfLoop(int u, int v) { return self_loop == false && u == v; }
-    bool JudgeMultiplyEdge(int u, int v) {
-        if (multiply_edge == true)
-            return false;
-        if (e[{u, v}])
-            return true;
-        if (direction == 0 && e[{v, u}])
-            return true;
-        return false;
+    void ShuffleEdge(bool keep_weight = false) {
+        if (!keep_weight) {
+            GenWeight();
+        }
+        if (weight.empty()) {
+            Shuffle(edge.begin(), edge.end());
+        } else {
+            for (size_t i = 1; i < edge.size(); i++) {
+                size_t j = thread_rnd->next((int)i + 1);
+                std::swap(edge[i], edge[j]);
+                std::swap(weight[i], weight[j]);
+            }
+        }
+        DebugVerify();
     }
-    void AddEdge(int u, int v) {
-        if (multiply_edge == false) {
-            e[{u, v}] = 1;
-            if (direction == false) {
-                e[{v, u}] = 1;
+    /**
+     * 访问另一个EdgeList的边集和边权，派生类用它不复制地读写其他生成器的结果
+     */
+    static std::vector<std::pair<int, int>>& EdgeOf(EdgeList& g) { return g.edge; }
+    static std::vector<long long>& WeightOf(EdgeList& g) { return g.weight; }
+    /**
+     * 定义了GRAPHGEN_VERIFY时，生成结束后检查生成的图是否满足类保证的性质，不满足时FailGen
+     */
+    void DebugVerify() {
+#ifdef GRAPHGEN_VERIFY
+        std::string res = Verify();
+        if (!res.empty()) {
+            FailGen("verification failed: %s.\n", res.c_str());
+        }
+#endif
+    }
+
+   public:
+    /**
+     * 用Verifier在O(n+m)内检查最近一次生成的结果是否满足类保证的性质
+     * @return 为空表示通过，否则为第一个不满足的性质
+     */
+    virtual std::string Verify() { return ""; }
+    /**
+     * 获取最近一次生成和输出的统计，需要定义GRAPHGEN_STATS
+     */
+    Stats GetStats() { return stats; }
+    /**
+     * 设置接受率的警告阈值，生成结束时接受率低于r就在stderr输出警告，需要定义GRAPHGEN_STATS
+     * @param r 阈值，默认为0.1，设为0时不警告
+     */
+    void SetStatsWarning(double r) { warn_rate = r; }
+    /**
+     * 获取边
+     * @return 边
+     */
+    std::vector<std::pair<int, int>> GetEdge() { return edge; }
+    /**
+     * 获取边数，不复制边集
+     */
+    int GetEdgeCount() { return edge.size(); }
+    /**
+     * 获取边权，和GetEdge()的边一一对应，没有边权时为空
+     * @return 边权
+     */
+    std::vector<long long> GetWeight() { return weight; }
+    /**
+     * 边权在[l,r]内均匀随机
+     * @param l 边权下界
+     * @param r 边权上界
+     */
+    void SetWeight(long long l, long long r) {
+        if (l > r) {
+            FailGen("weight range [%lld,%lld] is empty.\n", l, r);
+        }
+        weight_type = 1;
+        weight_min = l;
+        weight_max = r;
+    }
+    /**
+     * 边权为l+X，X服从参数为p的几何分布，即P(X=k)=(1-p)^k*p
+     * @param p 成功概率，范围为(0,1]，越小边权越大
+     * @param l 边权下界
+     */
+    void SetGeometricWeight(double p, long long l = 1) {
+        if (!(p > 0 && p <= 1)) {
+            FailGen("restriction of the p is (0,1].\n");
+        }
+        weight_type = 2;
+        weight_p = p;
+        weight_min = l;
+    }
+    /**
+     * 自定义边权
+     * @param f 边权函数，参数为边的两个端点(已经加上begin_node)，返回边权
+     */
+    void SetWeight(std::function<long long(int, int)> f) {
+        weight_type = 3;
+        weight_func = f;
+    }
+    /**
+     * 不生成边权
+     */
+    void ResetWeight() { weight_type = 0; }
+    /**
+     * 输出所有边，每行一条，没有边权时为"u v"，有边权时为"u v w"
+     * @param out 输出文件
+     */
+    void Output(FILE* out = stdout) {
+        Writer w(out);
+        Output(w);
+        StatPhase(PHASE_OUTPUT);
+        w.Flush();
+        StatPhase(-1);
+    }
+    /**
+     * 多线程输出所有边到文件，格式和Output相同：先按数位算出每块边的字节数并求前缀和，
+     * 把文件预分配成最终大小后映射到内存，各线程把自己的块直接格式化到对应位置
+     * @param file 输出文件，已经存在时覆盖
+     * @param head 写在边之前的内容，如"n m\n"
+     * @param thread 线程数
+     * @note 不支持mmap的平台上格式化到内存后一次写入
+     */
+    void OutputParallel(const std::string& file, const std::string& head = "", int thread = DefaultThread()) {
+        StatPhase(PHASE_OUTPUT);
+        const size_t CHUNK = 1 << 16;  // 每块的边数
+        size_t m = edge.size();
+        int chunk = (m + CHUNK - 1) / CHUNK;
+        std::vector<size_t> offset(chunk + 1, 0);
+        ParallelFor(chunk, thread, [&](int t) {
+            size_t len = 0, r = std::min(m, (size_t)(t + 1) * CHUNK);
+            for (size_t i = (size_t)t * CHUNK; i < r; i++) {
+                len += IntLength(edge[i].first) + IntLength(edge[i].second) + 2;
+                if (!weight.empty()) {
+                    len += IntLength(weight[i]) + 1;
+                }
+            }
+            offset[t + 1] = len;
+        });
+        offset[0] = head.size();
+        for (int t = 0; t < chunk; t++) {
+            offset[t + 1] += offset[t];
+        }
+        size_t total = offset[chunk];
+        auto format = [&](char* data) {
+            std::copy(head.begin(), head.end(), data);
+            ParallelFor(chunk, thread, [&](int t) {
+                char* p = data + offset[t];
+                size_t r = std::min(m, (size_t)(t + 1) * CHUNK);
+                for (size_t i = (size_t)t * CHUNK; i < r; i++) {
+                    p = FormatInt(p, edge[i].first);
+                    *p++ = ' ';
+                    p = FormatInt(p, edge[i].second);
+                    if (!weight.empty()) {
+                        *p++ = ' ';
+                        p = FormatInt(p, weight[i]);
+                    }
+                    *p++ = '\n';
+                }
+            });
+        };
+#ifndef _WIN32
+        int fd = open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            FailGen("cannot open %s.\n", file.c_str());
+        }
+        if (total == 0) {
+            close(fd);
+            StatPhase(-1);
+            return;
+        }
+        if (ftruncate(fd, total) != 0) {
+            close(fd);
+            FailGen("cannot resize %s to %zu bytes.\n", file.c_str(), total);
+        }
+        void* data = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            FailGen("cannot map %s.\n", file.c_str());
+        }
+        format((char*)data);
+        munmap(data, total);
+#else
+        std::vector<char> data(total);
+        format(data.data());
+        FILE* out = fopen(file.c_str(), "wb");
+        if (out == nullptr) {
+            FailGen("cannot open %s.\n", file.c_str());
+        }
+        fwrite(data.data(), 1, total, out);
+        fclose(out);
+#endif
+        StatPhase(-1);
+    }
+    /**
+     * 输出所有边到w
+     */
+    void Output(Writer& w) {
+        StatPhase(PHASE_OUTPUT);
+        for (size_t i = 0; i < edge.size(); i++) {
+            w.WriteInt(edge[i].first);
+            w.WriteChar(' ');
+            w.WriteInt(edge[i].second);
+            if (!weight.empty()) {
+                w.WriteChar(' ');
+                w.WriteInt(weight[i]);
+            }
+            w.WriteChar('\n');
+        }
+        StatPhase(-1);
+    }
+};
+// 一颗随机生成的树,默认为无根
+class Tree : public EdgeList {
+   protected:
+    unsigned int node_limit = 1e6;  // 结点数的上限
+    unsigned int edge_limit = 1e6;  // 边数的上限
+    int begin_node = 1;             // 结点开始编号
+    int node;                       // 结点数
+    // 是否是有根树,默认为false,如果是有根树的话，边为(father,son);否则边为(father,son)与(son,father)中的任意一个
+    bool is_root;
+    int root;                               // 根，默认为-1表示随机,只在is_rooted=1的时候生效
+    std::vector<int> p;
+    void JudgeLimits() {
+        if (node <= 0) {
+            FailGen("node must be a positive integer.\n");
+        }
+        if (node > node_limit) {
+            FailGen(
+                "node must less than or equal to %d, or you can change the "
+                "node_limit.\n",
+                node_limit);
+        }
+        if (is_root && root != -1 && (root < begin_node || root > node - 1 + begin_node)) {
+            FailGen("restriction of the root is [%d,%d]\n", begin_node,
+                    node - 1 + begin_node);
+        }
+    }
+    void Init() {
+        JudgeLimits();
+        edge.clear();
+        edge.reserve(node - 1);
+        RandPerm(p, node);
+        // 随机根时p[0]就是根
+        if (is_root && root != -1) {
+            for (int i = 0; i < node; i++) {
+                if (p[i] == root - begin_node) {
+                    std::swap(p[0], p[i]);
+                    break;
+                }
+            }
+        }
+    }
+    void AddEdge(int u, int v) {
+        u += begin_node;
+        v += begin_node;
+        if (is_root || thread_rnd->next(2)) {
+            edge.push_back({u, v});
+        } else {
+            edge.push_back({v, u});
+        }
+    }
+
+   public:
+    /**
+     * 默认为无根树
+     * @param n 结点数
+     * @param is_rt 是否有根
+     * @param rt 根,默认为-1表示随机,范围应为[begin_node,n-1+begin_node],只在is_root=true时生效
+     */
+    Tree(int n = 1, bool is_rt = 0, int rt = -1) {
+        node = n;
+        is_root = is_rt;
+        root = rt;
+    }
+    /**
+     * 设置结点数
+     * @param n 结点数
+     */
+    void SetNode(int n) { node = n; }
+    /**
+     * 设置无根/有根树,如果是有根树的话，边为(father,son);否则边为(father,son)与(son,father)中的任意一个
+     * @param is_rt 是否有根
+     */
+    void SetIsRoot(bool is_rt) { is_root = is_rt; }
+    /**
+     * 设置根，只在有根树的时候生效
+     * @param rt 根,范围应为[begin_node,n-1+begin_node],-1表示随机
+     */
+    void SetRoot(int rt) { root = rt; }
+    /**
+     * 获取根，只在有根的时候有效
+     * @return 根
+     * @note 随机根在生成之后才能获取
+     */
+    int GetRoot() {
+        if (!is_root) {
+            FailGen("Unroot Tree,but ask for get root.\n");
+        }
+        if (root != -1) {
+            return root;
+        }
+        if (p.empty()) {
+            FailGen("random root is decided when generating the tree.\n");
+        }
+        return p[0] + begin_node;
+    }
+    /**
+     * 设置点数上限
+     */
+    void SetNodeLimit(unsigned int n) {
+        node_limit = n;
+    }
+    /**
+     * 设置边数上限
+     */
+    void SetEdgeLimit(unsigned int m) {
+        edge_limit = m;
+    }
+    /**
+     * 设置第一个结点的编号
+     */
+    void SetBeginNode(int n) {
+        begin_node = n;
+    }
+    /**
+     * 检查是n个点的树，有根时边都从父亲指向儿子
+     */
+    virtual std::string Verify() {
+        Verifier v(node, edge, begin_node, is_root);
+        if (!v.InRange()) {
+            return "node out of range";
+        }
+        if ((int)edge.size() != node - 1) {
+            return "number of edges is not n-1";
+        }
+        if (!v.Connected()) {
+            return "not connected";
+        }
+        if (is_root && !v.Rooted(GetRoot())) {
+            return "edges are not directed away from the root";
+        }
+        return "";
+    }
+    /**
+     * 生成树
+     */
+    void GenTree() {
+        Init();
+        for (int i = 1; i < node; i++) {
+            int f = thread_rnd->next(i);
+            AddEdge(p[f], p[i]);
+        }
+        ShuffleEdge();
+    }
+};
+// 一条链，默认为无根树
+class Chain : public Tree {
+   public:
+    /**
+     * 一条链，默认为无根树
+     * @param n 结点数
+     * @param is_rt 是否有根
+     * @param rt 根,默认为-1表示随机,范围应为[begin_node,n-1+begin_node],只在is_root=true时生效
+     */
+    Chain(int n = 1, bool is_rt = 0, int rt = -1) {
+        node = n;
+        is_root = is_rt;
+        root = rt;
+    }
+    /**
+     * 生成树
+     */
+    void GenTree() {
+        Init();
+        for (int i = 1; i < node; i++) {
+            AddEdge(p[i - 1], p[i]);
+        }
+        ShuffleEdge();
+    }
+};
+// 一个菊花图，默认为无根树
+class Flower : public Tree {
+   public:
+    /**
+     * 一个菊花图，默认为无根树
+     * @param n 结点数
+     * @param is_rt 是否有根
+     * @param rt 根,默认为-1表示随机,范围应为[begin_node,n-1+begin_node],只在is_root=true时生效
+     */
+    Flower(int n = 1, bool is_rt = 0, int rt = -1) {
+        node = n;
+        is_root = is_rt;
+        root = rt;
+    }
+    /**
+     * 生成树
+     */
+    void GenTree() {
+        Init();
+        for (int i = 1; i < node; i++) {
+            AddEdge(p[0], p[i]);
+        }
+        ShuffleEdge();
+    }
+};
+// 一颗限制高度的树，必须有根
+class HeightTree : public Tree {
+   private:
+    int height;               // 树的高度
+    bool set_height;          // 判断是否设置树高
+    std::vector<int> number;  // 每层的点数，重复生成时复用
+   public:
+    /**
+     * 一个限制高度的树
+     * @param n 结点数
+     * @param is_rt 是否有根，必须有根
+     * @param h 树高度,不指定的话在生成的时候随机高度
+     * @param rt 根,默认为-1表示随机,范围应为[begin_node,n-1+begin_node]
+     */
+    HeightTree(int n = 1, int h = -1, int rt = -1) {
+        node = n;
+        is_root = 1;
+        root = rt;
+        set_height = 0;
+        if (h != -1) {
+            SetHeight(h);
+        }
+    }
+    /**
+     * 设置树的高度
+     * @param h 树高
+     */
+    void SetHeight(int h) {
+        height = h;
+        set_height = 1;
+    }
+    /**
+     * 设置树的高度为随机生成
+     */
+    void ResetHeight() { set_height = 0; }
+    /**
+     * 强制为有根树，函数不可调用
+     * @param is_rt 是否有根
+     */
+    void SetIsRoot(bool is_rt) = delete;
+    /**
+     * 检查是树并且层数为设置的高度
+     */
+    virtual std::string Verify() {
+        std::string res = Tree::Verify();
+        if (res.empty() && Verifier(node, edge, begin_node).Height(GetRoot()) != height) {
+            res = "height is not " + std::to_string(height);
+        }
+        return res;
+    }
+    /**
+     * 生成树
+     */
+    void GenTree() {
+        if (!set_height) {
+            SetHeight(thread_rnd->next(node == 1 ? 1 : 2, node));
+        }
+        if (height > node) {
+            FailGen("restriction of the height is [%d,%d].\n", node == 1 ? 1 : 2, node);
+        }
+        if ((node > 1 && height <= 1) || height < 1) {
+            FailGen("restriction of the height is [%d,%d].\n", node == 1 ? 1 : 2, node);
+        }
+        Init();
+        number.assign(height, 1);
+        int w = node - height;
+        for (int i = 1; i <= w; i++) {
+            number[thread_rnd->next(1, height - 1)]++;
+        }
+        int l = 0, r = 0, k = 0;
+        for (int i = 1; i < node; i++) {
+            if (r + number[k] == i) {
+                l = r;
+                r += number[k];
+                k++;
+            }
+            int f = thread_rnd->next(l, r - 1);
+            AddEdge(p[f], p[i]);
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 编译期确定的图生成标志，用作生成器内核的模板参数
+ * @note D：有向；M：允许重边；S：允许自环；C：保证连通
+ */
+template <bool D, bool M, bool S, bool C>
+struct GraphPolicy {
+    static constexpr bool direction = D;
+    static constexpr bool multiply_edge = M;
+    static constexpr bool self_loop = S;
+    static constexpr bool connect = C;
+};
+/**
+ * 把运行时的标志分派成编译期常量std::true_type或std::false_type后调用g
+ */
+template <typename G>
+void Branch(bool x, G&& g) {
+    if (x) {
+        g(std::true_type());
+    } else {
+        g(std::false_type());
+    }
+}
+/**
+ * 标志已经是编译期常量时直接调用g，不生成另一个分支
+ */
+template <bool B, typename G>
+void Branch(std::bool_constant<B> x, G&& g) {
+    g(x);
+}
+/**
+ * 把四个标志(bool或std::bool_constant)转成对应的GraphPolicy对象后调用f，用于从运行时标志的类分派到特化的内核
+ * @note 传入std::bool_constant的标志不会实例化另一种取值
+ */
+template <typename D, typename M, typename S, typename C, typename F>
+void DispatchPolicy(D d, M m, S s, C c, F&& f) {
+    Branch(d, [&](auto dv) {
+        Branch(m, [&](auto mv) {
+            Branch(s, [&](auto sv) {
+                Branch(c, [&](auto cv) {
+                    f(GraphPolicy<decltype(dv)::value, decltype(mv)::value, decltype(sv)::value,
+                                  decltype(cv)::value>());
+                });
+            });
+        });
+    });
+}
+// 普通图
+class Graph : public EdgeList {
+   protected:
+    unsigned int node_limit = 1e6;          // 结点数的上限
+    unsigned int edge_limit = 1e6;          // 边数的上限
+    int begin_node = 1;                     // 结点开始编号
+    int node, side;                         // 点数，边数
+    HashSet e;                              // 边的去重，键见Key
+    std::vector<int> p;                     // 结点的随机排列，重复生成时复用
+    /**
+     *0：无向
+     *1：有向
+     *默认无向图
+     */
+    bool direction;
+    /**
+     *0：无重边
+     *1：有重边
+     *默认无重边
+     */
+    bool multiply_edge;
+    /**
+     *0：无自环
+     *1：有自环
+     *默认无自环
+     */
+    bool self_loop;
+    /**
+     *0：不保证连通
+     *1：保证连通
+     *默认不保证连通
+     */
+    bool connect;
+    unsigned long long Key(int u, int v) {
+        if (!direction && u > v) {
+            std::swap(u, v);
+        }
+        return (unsigned long long)u * node + v;
+    }
+    /**
+     * 生成前清空边集和去重表，按边数预留空间，已经分配的空间不释放
+     */
+    void ClearEdge() {
+        long long m = std::min<long long>(std::max(side, 0), edge_limit);
+        edge.clear();
+        edge.reserve(m);
+        e.Reset(multiply_edge ? 0 : m);
+    }
+    bool JudgeSelfLoop(int u, int v) { return self_loop == false && u == v; }
+    bool JudgeMultiplyEdge(int u, int v) {
+        if (multiply_edge == true)
+            return false;
+        return e.Count(Key(u, v));
+    }
+    void AddEdge(int u, int v) {
+        if (multiply_edge == false) {
+            e.Insert(Key(u, v));
+        }
+        u += begin_node;
+        v += begin_node;
+        if (direction == true) {
+            edge.push_back({u, v});
+        } else {
+            if (thread_rnd->next(2)) {
+                edge.push_back({u, v});
+            } else {
+                edge.push_back({v, u});
+            }
+        }
+    }
+    /**
+     * Key的特化版本，方向由策略P决定
+     */
+    template <typename P>
+    unsigned long long Key(int u, int v) {
+        if constexpr (!P::direction) {
+            if (u > v) {
+                std::swap(u, v);
+            }
+        }
+        return (unsigned long long)u * node + v;
+    }
+    /**
+     * 拒绝采样的判断，策略P不允许自环或重边时才检查；无重边时通过检查的边同时插入去重表
+     * @return 是否拒绝(u,v)
+     */
+    template <typename P>
+    bool Reject(int u, int v) {
+        if constexpr (!P::self_loop) {
+            if (u == v) {
+                return true;
+            }
+        }
+        if constexpr (!P::multiply_edge) {
+            return !e.Insert(Key<P>(u, v));
+        }
+        return false;
+    }
+    /**
+     * AddEdge的特化版本
+     * @param checked (u,v)已经通过Reject<P>插入了去重表
+     */
+    template <typename P>
+    void AddEdge(int u, int v, bool checked = false) {
+        if constexpr (!P::multiply_edge) {
+            if (!checked) {
+                e.Insert(Key<P>(u, v));
+            }
+        }
+        u += begin_node;
+        v += begin_node;
+        if constexpr (P::direction) {
+            edge.push_back({u, v});
+        } else {
+            if (thread_rnd->next(2)) {
+                edge.push_back({u, v});
+            } else {
+                edge.push_back({v, u});
+            }
+        }
+    }
+    /**
+     * 按编译期策略P生成图的内核，GenGraph按运行时标志分派到这里
+     */
+    template <typename P>
+    void GenGraphCore() {
+        StatBegin();
+        ClearEdge();
+        JudgeLimits();
+        int m = side;
+        if constexpr (P::connect) {
+            m -= node - 1;
+            StatPhase(PHASE_PERM);
+            RandPerm(p, node);
+            StatPhase(PHASE_TREE);
+            for (int i = 1; i < node; i++) {
+                AddEdge<P>(p[thread_rnd->next(i)], p[i]);
+            }
+        }
+        StatPhase(PHASE_RANDOM);
+        while (m--) {
+            int u, v;
+            do {
+                u = thread_rnd->next(node);
+                v = thread_rnd->next(node);
+            } while (StatReject(Reject<P>(u, v)));
+            AddEdge<P>(u, v, true);
+        }
+        StatPhase(PHASE_SHUFFLE);
+        ShuffleEdge();
+        StatEnd(&e);
+    }
+    virtual void JudgeUpper() {
+        long long limit;
+        if (!multiply_edge) {
+            limit = (long long)node * (long long)(node - 1) / 2;
+            if (direction) {
+                limit *= 2;
+            }
+            if (self_loop) {
+                limit += node;
+            }
+            if (side > limit) {
+                FailGen("number of edges must less than or equal to %lld.\n",
+                        limit);
+            }
+        }
+    }
+    virtual void JudgeLimits() {
+        if (side < 0) {
+            FailGen("number of edges must be a non-negative integer.\n");
+        }
+        if (side > edge_limit) {
+            FailGen(
+                "number of edges must less than or equal to %d, or you can change "
+                "the edge_limit.\n",
+                edge_limit);
+        }
+        JudgeUpper();
+        if (connect) {
+            if (side < node - 1) {
+                FailGen("number of edges must greater than or equal to %d.\n",
+                        node - 1);
+            }
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     */
+    Graph(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+    }
+    /**
+     * 设置结点数
+     * @param n 结点数
+     */
+    void SetNode(int n) { node = n; }
+    /**
+     * 设置边数
+     * @param m 边数
+     */
+    void SetSide(int m) { side = m; }
+    /**
+     * 设置有向/无向图
+     * @param f 0：无向;1：有向;默认无向图
+     */
+    void SetDirection(bool f) { direction = f; }
+    /** Refactor for C++
+     * 设置能不能存在重边
+     * @param f 0：无重边;1：有重边;默认无重边
+     */
+    void SetMultiplyEdge(bool f) { multiply_edge = f; }
+    /**
+     * 设置能不能存在自环
+     * @param f 0：无自环;1：有自环;默认无自环
+     */
+    void SetSelfLoop(bool f) { self_loop = f; }
+    /**
+     * 设置保不保证一定连通
+     * @param f 0：不保证一定连通;1：保证一定连通;默认不保证一定连通
+     */
+    void SetConnect(bool f) { connect = f; }
+    /**
+     * 设置点数上限
+     */
+    void SetNodeLimit(unsigned int n) {
+        node_limit = n;
+    }
+    /**
+     * 设置边数上限
+     */
+    void SetEdgeLimit(unsigned int m) {
+        edge_limit = m;
+    }
+    /**
+     * 设置第一个结点的编号
+     */
+    void SetBeginNode(int n) {
+        begin_node = n;
+    }
+    /**
+     * 检查自环、重边和连通性是否符合设置，有向图检查弱连通
+     */
+    virtual std::string Verify() {
+        Verifier v(node, edge, begin_node, direction);
+        if (!v.InRange()) {
+            return "node out of range";
+        }
+        if (!self_loop && !v.NoSelfLoop()) {
+            return "self loop found";
+        }
+        if (!multiply_edge && !v.NoMultiplyEdge()) {
+            return "multiple edge found";
+        }
+        if (connect && !v.Connected()) {
+            return "not connected";
+        }
+        return "";
+    }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        DispatchPolicy(direction, multiply_edge, self_loop, connect,
+                       [&](auto policy) { GenGraphCore<decltype(policy)>(); });
+    }
+};
+/**
+ * 二分图
+ * @note 强制设direction=0,self_loop=0
+ */
+class BipartiteGraph : public Graph {
+   private:
+    int left, right;                        // 左部，右部大小
+    std::vector<int> part[2], degree[2];    // 两部的点和连通时每个点的度数，重复生成时复用
+    bool set_left;    // 是否要随机左部大小
+    void RandLeft() {
+        if (set_left == true) {
+            right = node - left;
+            if (left < 0 || right < 0) {
+                FailGen("left part or right part must greater than or equal to 0.\n");
+            }
+            return;
+        }
+        int l = 0, r = node / 2, limit;
+        if (multiply_edge == 0) {
+            if (side > r * (node - r)) {
+                FailGen("number of edges must less than or equal to %d.\n", r * (node - r));
+            }
+            while (l <= r) {
+                int mid = (l + r) / 2;
+                if (mid * (node - mid) < side) {
+                    l = mid + 1;
+                } else {
+                    limit = r;
+                    r = mid - 1;
+                }
+            }
+        } else {
+            limit = 1;
+        }
+        left = thread_rnd->next(limit, node / 2);
+        right = node - left;
+    }
+    virtual void JudgeUpper() {
+        long long limit;
+        if (!multiply_edge) {
+            limit = (long long)left * (long long)right;
+            if (side > limit) {
+                FailGen("number of edges must less than or equal to %lld.\n",
+                        limit);
+            }
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param l 左部大小，右部=点数-左部，不设采用随机值
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     */
+    BipartiteGraph(int n = 1, int m = 0, int l = -1) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        if (l != -1) {
+            set_left = true;
+            left = l;
+        }
+    }
+    /**
+     * 强制无向图，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 设置左部大小
+     * @param l 左部大小
+     */
+    void SetLeft(int l) {
+        left = l;
+        set_left = true;
+    }
+    /**
+     * 在Graph::Verify的基础上检查是二分图
+     */
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        if (res.empty() && !Verifier(node, edge, begin_node).Bipartite()) {
+            res = "odd cycle found";
+        }
+        return res;
+    }
+    /**
+     * 按编译期策略P生成图的内核，P的direction和self_loop必须为false
+     */
+    template <typename P>
+    void GenGraphCore() {
+        static_assert(!P::direction && !P::self_loop, "bipartite graph must be undirected without self loops");
+        StatBegin();
+        ClearEdge();
+        RandLeft();
+        JudgeLimits();
+        StatPhase(PHASE_PERM);
+        RandPerm(p, node);
+        // 左部大小每次随机，按点数预留后不再随大小变化重新分配
+        for (int i = 0; i < 2; i++) {
+            part[i].reserve(node);
+            degree[i].reserve(node);
+        }
+        part[0].assign(p.begin(), p.begin() + left);
+        part[1].assign(p.begin() + left, p.end());
+        int m = side;
+        if constexpr (P::connect) {
+            StatPhase(PHASE_TREE);
+            m -= node - 1;
+            degree[0].assign(left, 1);
+            degree[1].assign(right, 1);
+            for (int i = left; i < node - 1; i++) {
+                degree[0][thread_rnd->next(left)]++;
+            }
+            for (int i = right; i < node - 1; i++) {
+                degree[1][thread_rnd->next(right)]++;
+            }
+            int f = 0, d[2] = {node - 1, node - 1};
+            while (d[0] + d[1] > 0) {
+                for (int i = 0; i < (f == 0 ? left : right); i++) {
+                    if (degree[f][i] == 1) {
+                        if (d[f] == 1) {
+                            for (int j = 0; j < (f == 0 ? right : left); j++) {
+                                if (degree[f ^ 1][j] == 1) {
+                                    AddEdge<P>(part[f][i], part[f ^ 1][j]);
+                                    d[0]--;
+                                    d[1]--;
+                                    degree[f][i]--;
+                                    degree[f ^ 1][j]--;
+                                }
+                            }
+                        } else {
+                            int j;
+                            do {
+                                j = thread_rnd->next(f == 0 ? right : left);
+                            } while (degree[f ^ 1][j] < 2);
+                            AddEdge<P>(part[f][i], part[f ^ 1][j]);
+                            d[0]--;
+                            d[1]--;
+                            degree[f][i]--;
+                            degree[f ^ 1][j]--;
+                        }
+                    }
+                }
+                f ^= 1;
+            }
+        }
+        StatPhase(PHASE_RANDOM);
+        while (m--) {
+            int u, v;
+            do {
+                u = thread_rnd->any(part[0]);
+                v = thread_rnd->any(part[1]);
+            } while (StatReject(Reject<P>(u, v)));
+            AddEdge<P>(u, v, true);
+        }
+        StatPhase(PHASE_SHUFFLE);
+        ShuffleEdge();
+        StatEnd(&e);
+    }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        DispatchPolicy(std::false_type(), multiply_edge, std::false_type(), connect,
+                       [&](auto policy) { GenGraphCore<decltype(policy)>(); });
+    }
+};
+/**
+ * DAG
+ * @note 强制设self_loop=0,direction=1
+ */
+class DAG : public Graph {
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=1 有向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     */
+    DAG(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 1;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+    }
+    /**
+     * 强制无向图,禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无自环,禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 在Graph::Verify的基础上检查无环
+     */
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        if (res.empty() && !Verifier(node, edge, begin_node, true).Acyclic()) {
+            res = "cycle found";
+        }
+        return res;
+    }
+    /**
+     * 按编译期策略P生成图的内核，P的direction必须为true，self_loop必须为false
+     */
+    template <typename P>
+    void GenGraphCore() {
+        static_assert(P::direction && !P::self_loop, "DAG must be directed without self loops");
+        StatBegin();
+        ClearEdge();
+        JudgeLimits();
+        StatPhase(PHASE_PERM);
+        RandPerm(p, node);
+        int m = side;
+        if constexpr (P::connect) {
+            m = std::max(0, m - (node - 1));
+            StatPhase(PHASE_TREE);
+            for (int i = 1; i < node; i++) {
+                int f = thread_rnd->next(i);
+                AddEdge<P>(p[f], p[i]);
+            }
+        }
+        StatPhase(PHASE_RANDOM);
+        while (m--) {
+            int u, v;
+            do {
+                u = thread_rnd->next(node);
+                v = thread_rnd->next(node);
+                if (u > v) {
+                    std::swap(u, v);
+                }
+            } while (StatReject(Reject<P>(p[u], p[v])));
+            AddEdge<P>(p[u], p[v], true);
+        }
+        StatPhase(PHASE_SHUFFLE);
+        GenWeight();
+        DebugVerify();
+        StatEnd(&e);
+    }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        DispatchPolicy(std::true_type(), multiply_edge, std::false_type(), connect,
+                       [&](auto policy) { GenGraphCore<decltype(policy)>(); });
+    }
+};
+/**
+ * 方向、重边、自环、连通在编译期由策略P(GraphPolicy)确定的Graph
+ * @note 生成时直接调用特化的内核，不经过运行时分派；这四个标志的Set函数不可用
+ */
+template <typename P>
+class StaticGraph : public Graph {
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     */
+    StaticGraph(int n = 1, int m = 0) : Graph(n, m) {
+        direction = P::direction;
+        multiply_edge = P::multiply_edge;
+        self_loop = P::self_loop;
+        connect = P::connect;
+    }
+    void SetDirection(bool f) = delete;
+    void SetMultiplyEdge(bool f) = delete;
+    void SetSelfLoop(bool f) = delete;
+    void SetConnect(bool f) = delete;
+    /**
+     * 生成图
+     */
+    void GenGraph() { GenGraphCore<P>(); }
+};
+/**
+ * 重边、连通在编译期由策略P确定的BipartiteGraph，P有向或允许自环时编译失败
+ */
+template <typename P>
+class StaticBipartiteGraph : public BipartiteGraph {
+    static_assert(!P::direction && !P::self_loop, "bipartite graph must be undirected without self loops");
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param l 左部大小，不设采用随机值
+     */
+    StaticBipartiteGraph(int n = 1, int m = 0, int l = -1) : BipartiteGraph(n, m, l) {
+        multiply_edge = P::multiply_edge;
+        connect = P::connect;
+    }
+    void SetMultiplyEdge(bool f) = delete;
+    void SetConnect(bool f) = delete;
+    /**
+     * 生成图
+     */
+    void GenGraph() { GenGraphCore<P>(); }
+};
+/**
+ * 重边、连通在编译期由策略P确定的DAG，P无向或允许自环时编译失败
+ */
+template <typename P>
+class StaticDAG : public DAG {
+    static_assert(P::direction && !P::self_loop, "DAG must be directed without self loops");
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     */
+    StaticDAG(int n = 1, int m = 0) : DAG(n, m) {
+        multiply_edge = P::multiply_edge;
+        connect = P::connect;
+    }
+    void SetMultiplyEdge(bool f) = delete;
+    void SetConnect(bool f) = delete;
+    /**
+     * 生成图
+     */
+    void GenGraph() { GenGraphCore<P>(); }
+};
+/**
+ * 分层DAG
+ * @note 强制设self_loop=0,direction=1,multiply_edge=0
+ * @note 第i层(i>0)的每个点都有来自第i-1层的入边，所有边都从低层指向高层，所以最长路恰好经过layer个点
+ * @note 入度为0的点恰好是第0层的点，出度为0的点为最后一层的点加上额外指定的汇点
+ * @note 除保证结构的边外，其余边从所有合法点对中无放回地均匀抽取，不做拒绝
+ */
+class LayerDAG : public Graph {
+   private:
+    int layer;                    // 层数，-1表示随机
+    int source;                   // 源点数，即第0层大小，-1表示随机
+    int sink;                     // 汇点数，-1表示只有最后一层是汇点
+    int span;                     // 一条边最多跨越的层数，-1表示不限制
+    std::vector<int> layer_size;  // 指定的每层大小，为空表示随机
+    std::vector<int> size;        // 实际每层大小
+    std::vector<int> start;       // 每层在点序中的起始位置
+    std::vector<int> work;        // 每层非汇点个数，非汇点是每层的前work[i]个点
+    int level, reach;             // 实际的层数和跨越层数
+    long long low_side, high_side;  // 当前分层下边数的范围，见Fit
+    virtual void JudgeUpper() {}
+    /**
+     * 按当前的size和work算出边数的范围：至少要有骨架的边数，至多为所有可连的点对数
+     * @return 边数是否在范围内
+     */
+    bool Fit() {
+        reach = span == -1 ? level - 1 : span;
+        std::vector<long long> pre(level + 1, 0);
+        for (int i = 0; i < level; i++) {
+            pre[i + 1] = pre[i] + size[i];
+        }
+        low_side = high_side = 0;
+        for (int i = 1; i < level; i++) {
+            low_side += std::max(work[i - 1], size[i]);
+        }
+        for (int i = 0; i + 1 < level; i++) {
+            high_side += (long long)work[i] * (pre[std::min(i + reach, level - 1) + 1] - pre[i + 1]);
+        }
+        return low_side <= side && side <= high_side;
+    }
+    /**
+     * 随机每层大小：每层先放一个点，剩下的点逐个放到随机一层
+     * @return 在源点数和汇点数的限制下能否分出level层
+     */
+    bool RandSize() {
+        size.assign(level, 1);
+        std::vector<int> cand;
+        int rest = node - level;
+        if (source != -1) {
+            size[0] = source;
+            rest -= source - 1;
+        } else {
+            cand.push_back(0);
+        }
+        for (int i = 1; i < level; i++) {
+            cand.push_back(i);
+        }
+        // 指定汇点数时，最后一层的大小不能超过汇点数
+        int cap = (sink == -1 || level == 1) ? node : sink;
+        while (rest > 0) {
+            if (cand.empty()) {
+                return false;
+            }
+            int w = thread_rnd->next((int)cand.size());
+            int k = cand[w];
+            if (k == level - 1 && size[k] >= cap) {
+                std::swap(cand[w], cand.back());
+                cand.pop_back();
+                continue;
+            }
+            size[k]++;
+            rest--;
+        }
+        return size[level - 1] <= cap;
+    }
+    /**
+     * 最后一层有t个点、其余的层尽量平均的分层，t=-1时所有层都尽量平均
+     * @param late 除不尽时多出的点放在靠后的层，否则放在靠前的层；限制跨越层数时两种的点对数不同
+     * @return 在源点数和汇点数的限制下能否这样分层
+     */
+    bool EvenSize(int t, bool late) {
+        size.assign(level, 0);
+        int first = 0, rest = node, cnt = level;
+        if (source != -1) {
+            size[0] = source;
+            rest -= source;
+            first = 1;
+            cnt--;
+        }
+        if (t != -1 && cnt > 0) {
+            size[level - 1] = t;
+            rest -= t;
+            cnt--;
+        }
+        if (cnt == 0 && rest != 0) {
+            return false;
+        }
+        for (int i = 0; i < cnt; i++) {
+            size[first + i] = rest / cnt + (late ? i >= cnt - rest % cnt : i < rest % cnt);
+        }
+        for (int x : size) {
+            if (x < 1) {
+                return false;
+            }
+        }
+        return sink == -1 || level == 1 || size[level - 1] <= sink;
+    }
+    /**
+     * 随机选出除最后一层以外的汇点，每层至少留一个非汇点
+     * @return 汇点数是否可行
+     */
+    bool RandSink() {
+        work = size;
+        work[level - 1] = 0;
+        if (sink == -1) {
+            return true;
+        }
+        int extra = sink - size[level - 1];
+        std::vector<int> slot;
+        for (int i = 0; i < level - 1; i++) {
+            for (int j = 1; j < size[i]; j++) {
+                slot.push_back(i);
+            }
+        }
+        if (extra < 0 || extra > (int)slot.size()) {
+            return false;
+        }
+        for (int i = 0; i < extra; i++) {
+            int j = thread_rnd->next(i, (int)slot.size() - 1);
+            std::swap(slot[i], slot[j]);
+            work[slot[i]]--;
+        }
+        return true;
+    }
+    /**
+     * 从靠后的层开始选出除最后一层以外的汇点，靠后的层可连的点最少，这样损失的点对最少
+     * @return 汇点数是否可行
+     */
+    bool EvenSink() {
+        work = size;
+        work[level - 1] = 0;
+        if (sink == -1) {
+            return true;
+        }
+        int extra = sink - size[level - 1];
+        for (int i = level - 2; i >= 0 && extra > 0; i--) {
+            int k = std::min(extra, size[i] - 1);
+            work[i] -= k;
+            extra -= k;
+        }
+        return extra == 0;
+    }
+    /**
+     * 层数为L时能否满足所有限制，可行时分层结果留在size和work中
+     * @note 先试所有层尽量平均，它的骨架边最少、可连的点对最多；
+     * @note 指定汇点数时再调整最后一层的大小t，t越大骨架边和可连的点对都越多，二分出骨架边不超过边数的最大的t
+     */
+    bool EvenFit(int L) {
+        level = L;
+        for (bool late : {false, true}) {
+            if (EvenSize(-1, late) && EvenSink() && Fit()) {
+                return true;
+            }
+        }
+        if (sink == -1 || L == 1) {
+            return false;
+        }
+        for (bool late : {false, true}) {
+            auto small = [&](int t) {
+                if (!EvenSize(t, late) || !EvenSink()) {
+                    return false;
+                }
+                Fit();
+                return low_side <= side;
+            };
+            if (!small(1)) {
+                continue;
+            }
+            int l = 1, r = sink;
+            while (l < r) {
+                int mid = l + (r - l + 1) / 2;
+                if (small(mid)) {
+                    l = mid;
+                } else {
+                    r = mid - 1;
+                }
+            }
+            small(l);
+            if (side <= high_side) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * 在可行的层数中随机选一个：层数较少时逐个检查后等概率选取，
+     * 否则随机抽取层数检查，都不可行时从两端向中间逐个检查
+     */
+    int RandLevel() {
+        int hi = source == -1 ? node : node - source + 1;
+        if (hi <= 2048) {
+            std::vector<int> ok;
+            for (int L = 1; L <= hi; L++) {
+                if (EvenFit(L)) {
+                    ok.push_back(L);
+                }
+            }
+            if (!ok.empty()) {
+                return ok[thread_rnd->next((int)ok.size())];
+            }
+            return RandFallback(hi);
+        }
+        for (int t = 0; t < 64; t++) {
+            int L = thread_rnd->next(1, hi);
+            if (EvenFit(L)) {
+                return L;
+            }
+        }
+        // 边数很少时只有层数少的可行，很多时只有层数多的可行
+        for (int l = 1, r = hi; l <= r; l++, r--) {
+            if (EvenFit(l)) {
+                return l;
+            }
+            if (EvenFit(r)) {
+                return r;
+            }
+        }
+        return RandFallback(hi);
+    }
+    // 均匀分层都不可行时，随机抽取层数和分层再试，仍不可行就失败
+    int RandFallback(int hi) {
+        for (int t = 0; t < 1024; t++) {
+            level = thread_rnd->next(1, hi);
+            if (RandSize() && RandSink() && Fit()) {
+                return level;
+            }
+        }
+        FailGen("no number of layers satisfies the restrictions.\n");
+        return -1;
+    }
+    void RandLayerSize() {
+        if (span != -1 && span < 1) {
+            FailGen("span must be a positive integer.\n");
+        }
+        if (!layer_size.empty()) {
+            level = layer_size.size();
+            long long sum = 0;
+            for (int x : layer_size) {
+                if (x < 1) {
+                    FailGen("size of each layer must be a positive integer.\n");
+                }
+                sum += x;
+            }
+            if (sum != node) {
+                FailGen("sum of layer sizes must be equal to %d.\n", node);
+            }
+            if (source != -1 && source != layer_size[0]) {
+                FailGen("number of sources must be equal to the size of layer 0.\n");
+            }
+            size = layer_size;
+            for (int t = 0; t < 8; t++) {
+                if (RandSink() && Fit()) {
+                    return;
+                }
+            }
+            if (!EvenSink()) {
+                FailGen("restriction of the sink is [%d,%d].\n", size[level - 1], node - level + 1);
+            }
+            if (!Fit()) {
+                FailGen("number of edges must in [%lld,%lld] under the restrictions of layers.\n", low_side,
+                        high_side);
+            }
+            return;
+        }
+        if (source != -1 && (source < 1 || source > node)) {
+            FailGen("restriction of the source is [1,%d].\n", node);
+        }
+        level = layer == -1 ? RandLevel() : layer;
+        if (level < 1 || level > node) {
+            FailGen("restriction of the layer is [1,%d], but found %d.\n", node, level);
+        }
+        if (source != -1 && node - source < level - 1) {
+            FailGen("restriction of the source is [1,%d].\n", node - level + 1);
+        }
+        // 随机分层几次，都不满足时用EvenFit中的分层，再不行就多随机几次
+        for (int t = 0; t < 8; t++) {
+            if (RandSize() && RandSink() && Fit()) {
+                return;
+            }
+        }
+        if (EvenFit(level)) {
+            return;
+        }
+        for (int t = 0; t < 1024; t++) {
+            if (RandSize() && RandSink() && Fit()) {
+                return;
+            }
+        }
+        if (!EvenSize(-1, false) && !EvenSize(sink, false)) {
+            FailGen("can not divide %d nodes into %d layers under the restrictions.\n", node, level);
+        }
+        if (!EvenSink()) {
+            FailGen("restriction of the sink is [%d,%d].\n", size[level - 1], node - level + 1);
+        }
+        Fit();
+        FailGen("number of edges must in [%lld,%lld] under the restrictions of layers.\n", low_side, high_side);
+    }
+    // 点u可以连向的点在点序中的区间[Low(i),High(i)),i为u所在层
+    int Low(int i) { return start[i + 1]; }
+    int High(int i) { return start[std::min(i + reach, level - 1) + 1]; }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param k 层数，不指定的话在生成的时候随机层数
+     * @note 其余参数默认如下：
+     * @note direction=1 有向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note source 源点数随机
+     * @note sink 只有最后一层是汇点
+     * @note span 边跨越的层数不限制
+     */
+    LayerDAG(int n = 1, int m = 0, int k = -1) {
+        node = n;
+        side = m;
+        direction = 1;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        layer = k;
+        source = -1;
+        sink = -1;
+        span = -1;
+    }
+    /**
+     * 强制有向图,禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无重边,禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环,禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 不保证连通,禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 设置层数
+     * @param k 层数,-1表示随机
+     */
+    void SetLayer(int k) { layer = k; }
+    /**
+     * 设置最长路的长度(边数)，等价于设置层数为len+1
+     * @param len 最长路的长度
+     */
+    void SetLongestPath(int len) { layer = len + 1; }
+    /**
+     * 设置每层的大小，层数同时设为a.size()
+     * @param a 每层的大小，和应为结点数
+     */
+    void SetLayerSize(std::vector<int> a) {
+        layer_size = a;
+        layer = a.size();
+    }
+    /**
+     * 设置每层的大小为随机
+     */
+    void ResetLayerSize() { layer_size.clear(); }
+    /**
+     * 设置源点(入度为0的点)个数，即第0层的大小
+     * @param s 源点数,-1表示随机
+     */
+    void SetSource(int s) { source = s; }
+    /**
+     * 设置汇点(出度为0的点)个数，不能少于最后一层的大小
+     * @param t 汇点数,-1表示只有最后一层是汇点
+     */
+    void SetSink(int t) { sink = t; }
+    /**
+     * 设置一条边最多跨越的层数，用来控制层间的边密度
+     * @param d 跨越的层数,1表示只在相邻层之间连边,-1表示不限制
+     */
+    void SetSpan(int d) { span = d; }
+    /**
+     * 获取每层的大小
+     */
+    std::vector<int> GetLayerSize() { return size; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        if (node <= 0 || (unsigned int)node > node_limit) {
+            FailGen("restriction of the node is [1,%d].\n", node_limit);
+        }
+        JudgeLimits();
+        RandLayerSize();
+        start.assign(level + 1, 0);
+        for (int i = 0; i < level; i++) {
+            start[i + 1] = start[i] + size[i];
+        }
+        // 骨架：相邻两层之间取一个随机的边覆盖，使下层每个点有入边，上层每个非汇点有出边
+        std::vector<std::pair<int, int>> skeleton;
+        for (int i = 1; i < level; i++) {
+            int a = work[i - 1], b = size[i];
+            std::vector<int> q = thread_rnd->perm(std::max(a, b), 0);
+            for (int j = 0; j < std::max(a, b); j++) {
+                int u, v;
+                if (a <= b) {
+                    u = j < a ? j : thread_rnd->next(a);
+                    v = q[j];
+                } else {
+                    u = q[j];
+                    v = j < b ? j : thread_rnd->next(b);
+                }
+                skeleton.push_back({start[i - 1] + u, start[i] + v});
+            }
+        }
+        long long total = 0;
+        for (int i = 0; i + 1 < level; i++) {
+            total += (long long)work[i] * (High(i) - Low(i));
+        }
+        if (side < (long long)skeleton.size() || side > total) {
+            FailGen("number of edges must in [%d,%lld] under the restrictions of layers.\n",
+                    (int)skeleton.size(), total);
+        }
+        // 剩余的边在不含骨架边的合法点对中按编号无放回抽取
+        SortPair(skeleton, node);
+        std::vector<int> low(node, 0), high(node, 0);
+        for (int i = 0; i + 1 < level; i++) {
+            for (int u = start[i]; u < start[i] + work[i]; u++) {
+                low[u] = Low(i);
+                high[u] = High(i);
+            }
+        }
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        edge.reserve(side);
+        for (auto x : skeleton) {
+            edge.push_back({p[x.first] + begin_node, p[x.second] + begin_node});
+        }
+        for (auto x : SampleRange(low, high, skeleton, side - skeleton.size())) {
+            edge.push_back({p[x.first] + begin_node, p[x.second] + begin_node});
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 环图
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,side=n
+ */
+class CycleGraph : public Graph {
+   public:
+    /**
+     * @param n 结点数
+     * @note 其余参数默认如下：
+     * @note side=n 边数固定
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    CycleGraph(int n = 1) {
+        node = n;
+        side = n;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 设置点数
+     * @param n 节点数
+     */
+    void SetNode(int n) {
+        node = n;
+        side = n;
+    }
+    /**
+     * 强制边数等于点数，禁用函数
+     */
+    void SetSide(int m) = delete;
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 根据点集生成图
+     * @param a 点集
+     * @attention 如果结点集合有重复点则会产生错误
+     */
+    void GenGraph(const std::vector<int>& a) {
+        edge.clear();
+        Builder build(edge, begin_node, direction);
+        build.Reserve(a.size());
+        build.Cycle(a);
+        GenWeight();
+    }
+    /**
+     * 根据结点数生成图
+     */
+    void GenGraph() {
+        RandPerm(p, node);
+        GenGraph(p);
+        ShuffleEdge(true);
+    }
+};
+/**
+ * 轮图
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,side=2n-2
+ */
+class WheelGraph : public Graph {
+   private:
+    std::vector<int> rim;  // 轮上除支配点以外的点，重复生成时复用
+
+   public:
+    /**
+     * @param n 结点数
+     * @note 其余参数默认如下：
+     * @note side=2*n-2 边数固定
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    WheelGraph(int n = 1) {
+        node = n;
+        side = 2 * n - 2;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 设置结点数
+     * @param n 结点数
+     */
+    void SetNode(int n) {
+        node = n;
+        side = 2 * n - 2;
+    }
+    /**
+     * 强制边数等于2*node-2，禁用函数
+     */
+    void SetSide(int m) = delete;
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 根据指定支配点和其余点生成图
+     * @param v 指定点
+     * @param p 其余点
+     * @attention 如果结点集合有重复点则会产生错误
+     */
+    void GenGraph(int v, const std::vector<int>& p) {
+        edge.clear();
+        Builder build(edge, begin_node, direction);
+        build.Reserve(2 * p.size());
+        build.Cycle(p);
+        build.Star(v, p);
+        ShuffleEdge();
+    }
+    /**
+     * 根据指定点生成图，支配点随机
+     * @param p 点集，不可为空
+     * @attention 如果结点集合有重复点则会产生错误
+     */
+    void GenGraph(std::vector<int> p) {
+        Shuffle(p.begin(), p.end());
+        rim.assign(p.begin() + 1, p.end());
+        GenGraph(p[0], rim);
+    }
+    /**
+     * 根据点数生成图
+     */
+    void GenGraph() {
+        RandPerm(p, node);
+        rim.assign(p.begin() + 1, p.end());
+        GenGraph(p[0], rim);
+    }
+};
+/**
+ * 网格图
+ * @note 强制设connect=1,self_loop=0
+ */
+class GridGraph : public Graph {
+   protected:
+    int row = -1, column;                    // 行数，列数，第i行第j列的格子编号为i*column+j，p[x]为格子x对应的结点
+    std::vector<int> cell;                   // cell[u]为结点u所在的格子
+    std::vector<std::pair<int, int>> rest;   // 不在骨架里的相邻格子对
+    std::vector<int> possible;               // 边数足够的行数，重复生成时复用
+    /**
+     *0：不使用模式边权
+     *1：卡SPFA
+     *2：卡Dijkstra的堆
+     */
+    int pattern = 0;
+    long long intensity;  // 模式边权的强度
+    bool set_row = 0;     // 是否指定了行数
+    /**
+     * 按格子坐标给出模式边权，a<b为相邻的两个格子
+     */
+    long long PatternWeight(int a, int b) {
+        bool horizontal = a / column == b / column;
+        if (pattern == 1) {
+            return horizontal ? thread_rnd->next(1LL, intensity) : 1;
+        }
+        return horizontal ? 1 : 2 + intensity * (b % column);
+    }
+    long long CountSide(int x, int y) {
+        long long xl = (long long)x;
+        long long yl = (long long)y;
+        long long sum = xl * (yl - 1) + yl * (xl - 1) - 2 * ((yl - node % yl) % yl);
+        if (direction == 1) {
+            sum *= 2;
+        }
+        return sum;
+    }
+    virtual void JudgeUpper() {
+        long long limit = 0;
+        if (node == 1 && side > 0) {
+            FailGen("number of edges must be 0 when there is only one node.\n");
+        }
+        if (!multiply_edge) {
+            int x = sqrt(node), y = (node + x - 1) / x;
+            if (set_row) {
+                x = (node + row - 1) / row;
+                y = row;
+            }
+            limit = CountSide(x, y);
+            if (side > limit) {
+                FailGen("number of edges must less than or equal to %lld.\n",
+                        limit);
+            }
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    GridGraph(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 指定网格的行数，列数为ceil(n/r)
+     * @param r 行数，范围为[1,n]
+     */
+    void SetRow(int r) {
+        row = r;
+        set_row = 1;
+    }
+    /**
+     * 行数在生成时随机
+     */
+    void ResetRow() { set_row = 0; }
+    /**
+     * 卡SPFA的边权：同一行相邻格子的边权在[1,w]内均匀随机，同一列相邻格子的边权为1
+     * @param w 横向边权的上界，越大越难卡，w=1时所有边权都为1
+     * @note 行数少、每行很长的完整网格效果最好，比如用SetRow(10)，以GetCell(0,0)为源点
+     * @note 模式边权优先于SetWeight设置的分布
+     */
+    void SetAntiSPFA(long long w) {
+        if (w < 1) {
+            FailGen("w must be a positive integer.\n");
+        }
+        pattern = 1;
+        intensity = w;
+    }
+    /**
+     * 卡Dijkstra堆的边权：同一行相邻格子的边权为1，第j列连接上下两格的边权为2+k*j
+     * @param k 斜率，至少为2，越大过期元素和真实距离差得越多
+     * @note 无向的完整网格以GetCell(0,0)为源点时，第0行以外的每个格子都先被上方的格子用较大的距离松弛，
+     * @note 再被左边的格子改成最短路，堆里同时存在O(n)个过期元素
+     * @note 模式边权优先于SetWeight设置的分布
+     */
+    void SetAntiDijkstra(long long k = 2) {
+        if (k < 2) {
+            FailGen("k must be greater than or equal to 2.\n");
+        }
+        pattern = 2;
+        intensity = k;
+    }
+    /**
+     * 不生成边权，同时取消模式边权
+     */
+    void ResetWeight() {
+        pattern = 0;
+        EdgeList::ResetWeight();
+    }
+    /**
+     * 获取行数，生成之后有效
+     */
+    int GetRow() { return row; }
+    /**
+     * 获取列数，生成之后有效，最后一行可能不满
+     */
+    int GetColumn() { return column; }
+    /**
+     * 获取第i行第j列的结点，生成之后有效
+     * @param i 行，范围为[0,row-1]
+     * @param j 列，范围为[0,column-1]
+     */
+    int GetCell(int i, int j) {
+        if (i < 0 || i >= row || j < 0 || j >= column || i * column + j >= node) {
+            FailGen("cell (%d,%d) is out of the grid.\n", i, j);
+        }
+        return p[i * column + j] + begin_node;
+    }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        StatBegin();
+        edge.clear();
+        if (set_row && (row < 1 || row > node)) {
+            FailGen("restriction of the row is [1,%d].\n", node);
+        }
+        JudgeLimits();
+        int m = side;
+        int d[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        if (set_row) {
+            column = (node + row - 1) / row;
+        } else if (multiply_edge == 0) {
+            std::pair<int, int> max = {0, 0};
+            possible.clear();
+            for (int i = 1; i <= node; i++) {
+                int x = i, y = (node + i - 1) / i;
+                long long w = CountSide(y, x);
+                if (w > max.first) {
+                    max = {w, i};
+                }
+                if (w >= side) {
+                    possible.push_back(i);
+                }
+            }
+            if (possible.size() == 0) {
+                m = max.first;
+                row = max.second;
+                column = (node + row - 1) / row;
+            } else {
+                row = thread_rnd->any(possible);
+                column = (node + row - 1) / row;
+            }
+        } else {
+            row = thread_rnd->next(1, node);
+            column = (node + row - 1) / row;
+        }
+        m = std::max(0, m - (node - 1));
+        StatPhase(PHASE_PERM);
+        RandPerm(p, node);
+        StatPhase(PHASE_TREE);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(node - 1 + m);
+        // 骨架：每行从头到尾(奇数行反向)，再用第0列把各行串起来
+        rest.clear();
+        for (int x = 0; x < node; x++) {
+            int i = x / column, j = x % column;
+            if (j > 0) {
+                if (i % 2 == 0) {
+                    build.Edge(p[x - 1], p[x]);
+                } else {
+                    build.Edge(p[x], p[x - 1]);
+                }
+                if (direction && !multiply_edge) {
+                    rest.push_back(i % 2 == 0 ? std::make_pair(x, x - 1) : std::make_pair(x - 1, x));
+                }
+            }
+            if (i > 0) {
+                if (j == 0) {
+                    build.Edge(p[x - column], p[x]);
+                } else if (!multiply_edge) {
+                    rest.push_back({x - column, x});
+                }
+                if (direction && !multiply_edge) {
+                    rest.push_back({x, x - column});
+                }
+            }
+        }
+        StatPhase(PHASE_RANDOM);
+        if (!multiply_edge) {
+            // 剩下的边从不在骨架里的相邻格子对中无放回地选
+            m = std::min<long long>(m, rest.size());
+            for (int i = 0; i < m; i++) {
+                std::swap(rest[i], rest[thread_rnd->next(i, (int)rest.size() - 1)]);
+                build.Edge(p[rest[i].first], p[rest[i].second]);
+            }
+        }
+        while (multiply_edge && m--) {
+            int pos, k, px, py, nxt;
+            do {
+                pos = thread_rnd->next(node);
+                k = thread_rnd->next(4);
+                px = pos / column + d[k][0];
+                py = pos % column + d[k][1];
+                nxt = px * column + py;
+            } while (StatReject(px < 0 || px >= row || py < 0 || py >= column || nxt >= node));
+            build.Edge(p[pos], p[nxt]);
+        }
+        StatPhase(PHASE_SHUFFLE);
+        if (pattern == 0) {
+            ShuffleEdge();
+            StatEnd();
+            return;
+        }
+        cell.resize(node);
+        for (int i = 0; i < node; i++) {
+            cell[p[i]] = i;
+        }
+        weight.resize(edge.size());
+        for (size_t i = 0; i < edge.size(); i++) {
+            int a = cell[edge[i].first - begin_node], b = cell[edge[i].second - begin_node];
+            weight[i] = PatternWeight(std::min(a, b), std::max(a, b));
+        }
+        ShuffleEdge(true);
+        StatEnd();
+    }
+};
+/**
+ * 基环树
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=0,side=n
+ */
+class PseudoTree : public Graph {
+   public:
+    /**
+     * @param n 结点数
+     * @attention n>=3,否则会产生问题
+     * @note 其余参数默认如下：
+     * @note side=n 边数固定
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    PseudoTree(int n = 3) {
+        node = n;
+        side = n;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 设置点数
+     * @param n 点数
+     */
+    void SetNode(int n) {
+        node = n;
+        side = node;
+    }
+    /**
+     * 强制边数等于点数，禁用函数
+     */
+    void SetSide(int m) = delete;
+    /**
+     * 强制无向，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 在Graph::Verify的基础上检查恰好有n条边，连通且n条边说明恰好有一个环
+     */
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        if (res.empty() && (int)edge.size() != node) {
+            res = "number of edges is not n";
+        }
+        return res;
+    }
+    /**
+     * 根据指定环大小生成图，如果不传入参数则随机环大小
+     * @param size 环大小
+     */
+    void GenGraph(int size = -1) {
+        edge.clear();
+        if (size == -1) {
+            size = thread_rnd->next(3, node);
+        }
+        if (size > node || size < 3) {
+            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+        }
+        size = std::min(size, node);
+        RandPerm(p, node);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(node);
+        build.Cycle(p, 0, size);
+        build.Grow(p, size, node);
+        ShuffleEdge();
+    }
+};
+/**
+ * 基环内向树
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=1,side=n
+ */
+class PseudoInTree : public PseudoTree {
+   public:
+    /**
+     * @param n 结点数
+     * @attention n>=3,否则会产生问题
+     * @note 其余参数默认如下：
+     * @note side=n 边数固定
+     * @note direction=1 有向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    PseudoInTree(int n = 3) {
+        node = n;
+        side = n;
+        direction = 1;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 强制有向，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 在PseudoTree::Verify的基础上检查每个点的出度都为1
+     */
+    virtual std::string Verify() {
+        std::string res = PseudoTree::Verify();
+        if (res.empty() && !Verifier(node, edge, begin_node, true).Functional()) {
+            res = "out degree is not 1";
+        }
+        return res;
+    }
+    /**
+     * 根据指定环大小生成图，如果不传入参数则随机环大小
+     * @param size 环大小
+     */
+    void GenGraph(int size = -1) {
+        edge.clear();
+        if (size == -1) {
+            size = thread_rnd->next(3, node);
+        }
+        if (size > node || size < 3) {
+            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+        }
+        size = std::min(size, node);
+        RandPerm(p, node);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(node);
+        build.Cycle(p, 0, size);
+        build.Grow(p, size, node, true);
+        ShuffleEdge();
+    }
+};
+/**
+ * 基环外向树
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=1,side=n
+ */
+class PseudoOutTree : public PseudoTree {
+   public:
+    /**
+     * @param n 结点数
+     * @attention n>=3,否则会产生问题
+     * @note 其余参数默认如下：
+     * @note side=n 边数固定
+     * @note direction=1 有向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    PseudoOutTree(int n = 3) {
+        node = n;
+        side = n;
+        direction = 1;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 强制有向，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 在PseudoTree::Verify的基础上检查每个点的入度都为1
+     */
+    virtual std::string Verify() {
+        std::string res = PseudoTree::Verify();
+        if (res.empty() && !Verifier(node, edge, begin_node, true).Functional(true)) {
+            res = "in degree is not 1";
+        }
+        return res;
+    }
+    /**
+     * 根据指定环大小生成图，如果不传入参数则随机环大小
+     * @param size 环大小
+     */
+    void GenGraph(int size = -1) {
+        edge.clear();
+        if (size == -1) {
+            size = thread_rnd->next(3, node);
+        }
+        if (size > node || size < 3) {
+            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+        }
+        size = std::min(size, node);
+        RandPerm(p, node);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(node);
+        build.Cycle(p, 0, size);
+        build.Grow(p, size, node);
+        ShuffleEdge();
+    }
+};
+/**
+ * 仙人掌
+ * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=0
+ * @note 仙人掌的边数的范围应该是[n-1,n-1+(n-1)/2]
+ */
+class Cactus : public Graph {
+   private:
+    std::vector<int> cnt, start;  // 每组的点数和起始位置，重复生成时复用
+    virtual void JudgeUpper() {
+        int limit = node - 1 + (node - 1) / 2;
+        if (side > limit) {
+            FailGen("number of edges must less than or equal to %d.\n", limit);
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    Cactus(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+    }
+    /**
+     * 强制无向，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制有无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 在Graph::Verify的基础上检查每条边最多在一个环上
+     */
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        if (res.empty() && !Verifier(node, edge, begin_node).Cactus()) {
+            res = "edge on more than one cycle";
+        }
+        return res;
+    }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        JudgeLimits();
+        int m = side;
+        m -= node - 1;
+        // 每组点的个数：第一个环3个点，其余环2个点，再随机多分配add个点；剩下的点各自成组
+        // 组数每次不同但不超过点数，按点数预留后不再重新分配
+        cnt.reserve(node);
+        start.reserve(node + 1);
+        if (m == 0) {
+            cnt.assign(1, 1);
+        } else {
+            cnt.assign(m, 2);
+            cnt[0] = 3;
+            int add = thread_rnd->next(0, node - (2 * m + 1));
+            for (int i = 0; i < add; i++) {
+                cnt[thread_rnd->next(m)]++;
+            }
+        }
+        int sum = 0;
+        for (int x : cnt) {
+            sum += x;
+        }
+        cnt.resize(cnt.size() + node - sum, 1);
+        Shuffle(cnt.begin() + 1, cnt.end());
+        RandPerm(p, node);
+        start.assign(cnt.size() + 1, 0);
+        for (int i = 0; i < (int)cnt.size(); i++) {
+            start[i + 1] = start[i] + cnt[i];
+        }
+        // 每组连到前面随机一组的随机一个点上，和这个点构成一个环
+        Builder build(edge, begin_node, direction);
+        build.Reserve(side);
+        build.Cycle(p, 0, cnt[0]);
+        for (int i = 1; i < (int)cnt.size(); i++) {
+            int w = thread_rnd->next(i);
+            int x = p[start[w] + thread_rnd->next(cnt[w])];
+            build.Path(p, start[i], start[i + 1]);
+            build.Edge(x, p[start[i]]);
+            if (cnt[i] > 1) {
+                build.Edge(x, p[start[i + 1] - 1]);
+            }
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 正则图，无向时每个点度数都为d，有向时每个点出度和入度都为d
+ * @note 用配置模型随机配对，再对自环和重边做随机换边修复，不整体重来
+ * @note 无向时自环贡献2的度数；d>=3时几乎一定连通，但不保证连通
+ */
+class RegularGraph : public Graph {
+   private:
+    int degree;        // 度数
+    HashSet edge_set;  // 边的去重
+    unsigned long long Key(int u, int v) {
+        if (!direction && u > v) {
+            std::swap(u, v);
+        }
+        return (unsigned long long)u * node + v;
+    }
+    virtual void JudgeUpper() {
+        if (degree < 0) {
+            FailGen("degree must be a non-negative integer.\n");
+        }
+        if (!multiply_edge && degree > node - 1 + (self_loop && direction)) {
+            FailGen("degree must less than or equal to %d.\n", node - 1 + (self_loop && direction));
+        }
+        if (!direction && (long long)node * degree % 2 == 1) {
+            FailGen("node * degree must be even in an undirected regular graph.\n");
+        }
+    }
+    // 生成度数为d的正则图，结果为0开始编号；随机配对后换边消去自环和重边，极小的图可能无边可换，这时重新配对
+    void Configure(int d, std::vector<std::pair<int, int>>& res) {
+        for (int round = 0; round < 64; round++) {
+            if (Pair(d, res)) {
+                return;
+            }
+        }
+        FailGen("can not generate a regular graph with degree %d, try again with another seed.\n", d);
+    }
+    // 一次随机配对和换边，换边失败太多次时返回false
+    bool Pair(int d, std::vector<std::pair<int, int>>& res) {
+        long long total = (long long)node * d;
+        long long m = direction ? total : total / 2;
+        res.resize(m);
+        std::vector<int> stub(total);
+        for (long long i = 0; i < total; i++) {
+            stub[i] = i / d;
+        }
+        Shuffle(stub.begin(), stub.end());
+        for (long long i = 0; i < m; i++) {
+            res[i] = direction ? std::make_pair((int)(i / d), stub[i]) : std::make_pair(stub[2 * i], stub[2 * i + 1]);
+        }
+        if (multiply_edge && self_loop) {
+            return true;
+        }
+        edge_set.Reset(m);
+        std::vector<long long> bad;
+        for (long long i = 0; i < m; i++) {
+            int u = res[i].first, v = res[i].second;
+            if ((!self_loop && u == v) || (!multiply_edge && !edge_set.Insert(Key(u, v)))) {
+                bad.push_back(i);
+            }
+        }
+        // 对每条坏边(u,v)随机找一条好边(x,y)，换成(u,x),(v,y)或(u,y),(x,v)
+        std::vector<char> is_bad(m, 0);
+        for (long long i : bad) {
+            is_bad[i] = 1;
+        }
+        long long fail = 0;
+        while (!bad.empty()) {
+            long long i = bad.back();
+            int u = res[i].first, v = res[i].second;
+            // 和它重复的边已经被换走，这条边不再是坏边
+            if ((self_loop || u != v) && !multiply_edge && edge_set.Insert(Key(u, v))) {
+                is_bad[i] = 0;
+                bad.pop_back();
+                continue;
+            }
+            if (++fail > 100LL * m + 1000) {
+                return false;
+            }
+            long long j = thread_rnd->next(m);
+            if (is_bad[j]) {
+                continue;
+            }
+            int x = res[j].first, y = res[j].second;
+            if (!direction && thread_rnd->next(2)) {
+                std::swap(x, y);
+            }
+            std::pair<int, int> a = {u, y}, b = {x, v};
+            if (!direction) {
+                a = {u, x};
+                b = {v, y};
+            }
+            if (!self_loop && (a.first == a.second || b.first == b.second)) {
+                continue;
+            }
+            if (!multiply_edge && (Key(a.first, a.second) == Key(b.first, b.second) ||
+                                   edge_set.Count(Key(a.first, a.second)) || edge_set.Count(Key(b.first, b.second)))) {
+                continue;
+            }
+            if (!multiply_edge) {
+                edge_set.Erase(Key(x, y));
+                edge_set.Insert(Key(a.first, a.second));
+                edge_set.Insert(Key(b.first, b.second));
+            }
+            res[i] = a;
+            res[j] = b;
+            is_bad[i] = 0;
+            bad.pop_back();
+            fail = 0;
+        }
+        return true;
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param d 度数
+     * @note 其余参数默认如下：
+     * @note side 无向时为n*d/2，有向时为n*d
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     */
+    RegularGraph(int n = 1, int d = 0) {
+        node = n;
+        degree = d;
+        side = 0;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+    }
+    /**
+     * 设置度数
+     * @param d 度数
+     */
+    void SetDegree(int d) { degree = d; }
+    /**
+     * 边数由点数和度数决定，禁用函数
+     */
+    void SetSide(int m) = delete;
+    /**
+     * 不保证连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        if (node <= 0 || (unsigned int)node > node_limit) {
+            FailGen("restriction of the node is [1,%d].\n", node_limit);
+        }
+        side = 0;
+        JudgeUpper();
+        long long m = (long long)node * degree / (direction ? 1 : 2);
+        if (m > edge_limit) {
+            FailGen("number of edges must less than or equal to %d, or you can change the edge_limit.\n",
+                    edge_limit);
+        }
+        side = m;
+        std::vector<std::pair<int, int>> res;
+        int rest = node - 1 - degree;
+        if (!multiply_edge && !self_loop && rest < degree) {
+            // 度数过大时换边很难成功，改为生成补图再取补
+            Configure(rest, res);
+            std::vector<int> head(node + 1, 0), to(res.size() * (direction ? 1 : 2)), mark(node, -1);
+            for (auto x : res) {
+                head[x.first + 1]++;
+                if (!direction) {
+                    head[x.second + 1]++;
+                }
+            }
+            for (int i = 0; i < node; i++) {
+                head[i + 1] += head[i];
+            }
+            std::vector<int> pos(head.begin(), head.end() - 1);
+            for (auto x : res) {
+                to[pos[x.first]++] = x.second;
+                if (!direction) {
+                    to[pos[x.second]++] = x.first;
+                }
+            }
+            edge.reserve(m);
+            for (int u = 0; u < node; u++) {
+                for (int i = head[u]; i < head[u + 1]; i++) {
+                    mark[to[i]] = u;
+                }
+                for (int v = direction ? 0 : u + 1; v < node; v++) {
+                    if (v != u && mark[v] != u) {
+                        if (direction || thread_rnd->next(2)) {
+                            edge.push_back({u + begin_node, v + begin_node});
+                        } else {
+                            edge.push_back({v + begin_node, u + begin_node});
+                        }
+                    }
+                }
+            }
+        } else {
+            Configure(degree, res);
+            edge.reserve(m);
+            for (auto x : res) {
+                edge.push_back({x.first + begin_node, x.second + begin_node});
+            }
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * Chung-Lu幂律图，每个点的期望度数服从幂律分布
+ * @note 第i个点的权重为(i+1)^(-1/(exponent-1))，边的两个端点都按权重用别名表抽取
+ * @note 无重边/无自环时遇到不合法的边会重抽，连续1000次抽不到时之后的边改为均匀抽取端点
+ */
+class ChungLuGraph : public Graph {
+   private:
+    double exponent;   // 幂律指数
+    int max_degree;    // 期望度数的上限,-1表示不限制
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param gamma 幂律指数，应大于1
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     * @note max_degree=-1 期望度数不限制
+     */
+    ChungLuGraph(int n = 1, int m = 0, double gamma = 2.5) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        exponent = gamma;
+        max_degree = -1;
+    }
+    /**
+     * 设置幂律指数
+     * @param gamma 幂律指数，应大于1，越小度数越集中在少数点上
+     */
+    void SetExponent(double gamma) { exponent = gamma; }
+    /**
+     * 按平均度数设置边数，需要在设置点数和方向之后调用
+     * @param d 平均度数，有向时为平均出度
+     */
+    void SetAverageDegree(double d) { side = (long long)(d * node / (direction ? 1 : 2) + 0.5); }
+    /**
+     * 设置期望度数的上限
+     * @param d 度数上限,-1表示不限制
+     */
+    void SetMaxDegree(int d) { max_degree = d; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        ClearEdge();
+        JudgeLimits();
+        if (exponent <= 1) {
+            FailGen("exponent must be greater than 1.\n");
+        }
+        if (side == 0) {
+            weight.clear();
+            return;
+        }
+        std::vector<double> w(node);
+        for (int i = 0; i < node; i++) {
+            w[i] = pow(i + 1, -1.0 / (exponent - 1));
+        }
+        // 把期望度数截断到上限，截断后总权重变小，迭代几次使其收敛
+        for (int t = 0; t < 8 && max_degree != -1; t++) {
+            double sum = 0;
+            for (double x : w) {
+                sum += x;
+            }
+            double cap = max_degree * sum / (direction ? side : 2.0 * side);
+            for (double& x : w) {
+                x = std::min(x, cap);
+            }
+        }
+        AliasTable table(w);
+        // 出点和入点用不同的编号排列，有向时出度大的点和入度大的点不同
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        std::vector<int> q = direction ? thread_rnd->perm(node, 0) : p;
+        int m = side;
+        if (connect) {
+            m -= node - 1;
+            for (int i = 1; i < node; i++) {
+                AddEdge(p[thread_rnd->next(i)], p[i]);
+            }
+        }
+        // 连续很多次抽不到合法的边时，说明权重大的点已经连满，这一条边改为均匀抽取端点
+        int fail = 0;
+        while (m--) {
+            int u, v;
+            do {
+                if (fail > 1000) {
+                    u = thread_rnd->next(node);
+                    v = thread_rnd->next(node);
+                } else {
+                    u = p[table.Next()];
+                    v = q[table.Next()];
+                    fail++;
+                }
+            } while (JudgeSelfLoop(u, v) || (!multiply_edge && !e.Insert(Key(u, v))));
+            fail = 0;
+            edge.push_back({u + begin_node, v + begin_node});
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 偏好依附(Barabasi-Albert)图，点依次加入，每个新点连向已有的点，被连的概率和度数+1成正比
+ * @note 用端点重复数组抽样，每次O(1)，度数分布的幂律指数约为3
+ * @note 边数平均分给每个新点；有向时边从新点指向旧点
+ * @note 每个新点的第一条边一定连向旧点，所以边数不少于n-1时图一定连通
+ */
+class PreferentialGraph : public Graph {
+   private:
+    int max_degree;  // 度数上限,-1表示不限制
+    // 每个点连出的边数
+    std::vector<int> Quota() {
+        std::vector<int> k(node, 0);
+        if (node == 1) {
+            return k;
+        }
+        std::vector<int> p = thread_rnd->perm(node - 1, 1);
+        for (int i = 1; i < node; i++) {
+            k[i] = side / (node - 1);
+        }
+        for (int i = 0; i < side % (node - 1); i++) {
+            k[p[i]]++;
+        }
+        if (multiply_edge) {
+            return k;
+        }
+        // 无重边时第i个点最多连出i条边(允许自环时为i+1条)，多出的边依次分给后面的点
+        long long carry = 0;
+        for (int i = 1; i < node; i++) {
+            int cap = i + self_loop;
+            carry += k[i];
+            k[i] = std::min<long long>(cap, carry);
+            carry -= k[i];
+        }
+        for (int i = node - 1; i >= 1 && carry > 0; i--) {
+            int add = std::min<long long>(i + self_loop - k[i], carry);
+            k[i] += add;
+            carry -= add;
+        }
+        if (carry > 0) {
+            FailGen("number of edges is too large for a preferential attachment graph.\n");
+        }
+        return k;
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     * @note max_degree=-1 度数不限制
+     */
+    PreferentialGraph(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        max_degree = -1;
+    }
+    /**
+     * 按平均度数设置边数，需要在设置点数和方向之后调用
+     * @param d 平均度数，有向时为平均出度
+     */
+    void SetAverageDegree(double d) { side = (long long)(d * node / (direction ? 1 : 2) + 0.5); }
+    /**
+     * 设置度数上限，达到上限的点不再被新点连接
+     * @param d 度数上限,-1表示不限制
+     */
+    void SetMaxDegree(int d) { max_degree = d; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        JudgeLimits();
+        std::vector<int> k = Quota();
+        if (max_degree != -1 && *std::max_element(k.begin(), k.end()) > max_degree) {
+            FailGen("max degree must greater than or equal to %d.\n", *std::max_element(k.begin(), k.end()));
+        }
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        // add[t]为本轮中点t已经增加的度数，点i本轮一定增加k[i]
+        std::vector<int> pool, degree(node, 0), add(node, 0), mark(node, -1), pick;
+        pool.reserve(node + 2 * side);
+        edge.reserve(side);
+        for (int i = 0; i < node; i++) {
+            pick.clear();
+            add[i] = k[i];
+            bool joined = false;
+            long long attempt = 0;
+            while ((int)pick.size() < k[i]) {
+                if (pick.size() == 1 && self_loop && !joined) {
+                    pool.push_back(i);
+                    joined = true;
+                }
+                if (pool.empty() || ++attempt > 100LL * (k[i] + (long long)pool.size())) {
+                    FailGen("can not find enough nodes to connect under the max degree.\n");
+                }
+                int w = thread_rnd->next((int)pool.size());
+                int t = pool[w];
+                if (max_degree != -1 && degree[t] + add[t] >= max_degree) {
+                    std::swap(pool[w], pool.back());
+                    pool.pop_back();
+                    continue;
+                }
+                if (!multiply_edge && mark[t] == i) {
+                    continue;
+                }
+                mark[t] = i;
+                add[t]++;
+                pick.push_back(t);
+            }
+            if (!joined) {
+                pool.push_back(i);
+            }
+            add[i] = 0;
+            for (int t : pick) {
+                add[t] = 0;
+                degree[i]++;
+                degree[t]++;
+                pool.push_back(i);
+                pool.push_back(t);
+                int u = p[i] + begin_node, v = p[t] + begin_node;
+                if (direction || thread_rnd->next(2)) {
+                    edge.push_back({u, v});
+                } else {
+                    edge.push_back({v, u});
+                }
+            }
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * R-MAT(Kronecker)图，点数取2的幂时和Graph500的生成方式相同
+ * @note 每条边从整个邻接矩阵开始，每层按概率a,b,c,d选一个象限，直到确定一个位置
+ * @note 边分块并行生成，每块有独立的随机数种子，结果和线程数无关
+ * @note 无重边时用并行排序去重，不够的边再补生成；补生成几轮仍不够时(接近完全图)，剩下的边从没选过的点对中均匀选
+ */
+class RMatGraph : public Graph {
+   private:
+    double prob[4];  // 四个象限的概率
+    double noise;    // 每层概率的扰动幅度
+    bool scramble;   // 是否打乱点的编号
+    int thread;      // 线程数
+    static const int CHUNK = 1 << 16;
+    static const int RETRY = 1 << 20;  // 一条边最多抽取的次数
+    // 生成count条边，放到key[from,from+count)中，边编码为(u<<32|v)，无向时u<=v
+    void Generate(std::vector<unsigned long long>& key, size_t from, size_t count, int scale,
+                  const std::vector<std::array<unsigned long long, 3>>& level) {
+        int chunk = (count + CHUNK - 1) / CHUNK;
+        std::vector<long long> seed(chunk);
+        for (int i = 0; i < chunk; i++) {
+            seed[i] = thread_rnd->next(1LL << 62);
+        }
+        // 工作线程里不能FailGen，记下抽不到合法边的块，结束后再报错
+        std::vector<char> stuck(chunk, 0);
+        ParallelFor(chunk, thread, [&](int t) {
+            random_t rng;
+            rng.setSeed(seed[t]);
+            size_t r = std::min(count, (size_t)(t + 1) * CHUNK);
+            for (size_t i = (size_t)t * CHUNK; i < r; i++) {
+                unsigned long long u, v;
+                int tries = 0;
+                do {
+                    if (++tries > RETRY) {
+                        stuck[t] = 1;
+                        return;
+                    }
+                    u = v = 0;
+                    // 一个63位随机数拆成3个21位随机数用
+                    unsigned long long bits = 0;
+                    for (int k = 0; k < scale; k++) {
+                        if (k % 3 == 0) {
+                            bits = rng.next(0x7fffffffffffffffLL);
+                        }
+                        unsigned long long x = bits & ((1 << 21) - 1);
+                        bits >>= 21;
+                        int q = x < level[k][0] ? 0 : x < level[k][1] ? 1 : x < level[k][2] ? 2 : 3;
+                        u = u << 1 | (q >> 1);
+                        v = v << 1 | (q & 1);
+                    }
+                } while (u >= (unsigned long long)node || v >= (unsigned long long)node || (!self_loop && u == v));
+                if (!direction && u > v) {
+                    std::swap(u, v);
+                }
+                key[from + i] = u << 32 | v;
+            }
+        });
+        if (std::count(stuck.begin(), stuck.end(), 1)) {
+            FailGen("can not generate an edge in range with the probability.\n");
+        }
+    }
+    // R-MAT补生成几轮仍不够时，剩下的边从还没有选过的点对中均匀选出，key已排序去重
+    void Complement(std::vector<unsigned long long>& key, size_t need) {
+        std::vector<int> low(node), high(node, node);
+        std::vector<std::pair<int, int>> ban;
+        ban.reserve(key.size() + (direction && !self_loop ? node : 0));
+        size_t j = 0;
+        for (int u = 0; u < node; u++) {
+            low[u] = direction ? 0 : self_loop ? u : u + 1;
+            for (; j < key.size() && (int)(key[j] >> 32) == u; j++) {
+                int v = key[j] & 0xffffffffULL;
+                // 有向无自环时(u,u)也不能选，按顺序插入ban中
+                if (direction && !self_loop && v > u && (ban.empty() || ban.back() < std::make_pair(u, u))) {
+                    ban.push_back({u, u});
+                }
+                ban.push_back({u, v});
+            }
+            if (direction && !self_loop && (ban.empty() || ban.back() < std::make_pair(u, u))) {
+                ban.push_back({u, u});
+            }
+        }
+        for (auto x : SampleRange(low, high, ban, need)) {
+            key.push_back((unsigned long long)x.first << 32 | x.second);
+        }
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     * @note a,b,c,d=0.57,0.19,0.19,0.05 Graph500的参数
+     * @note noise=0 不扰动
+     * @note scramble=1 打乱点的编号
+     */
+    RMatGraph(int n = 1, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        SetProbability(0.57, 0.19, 0.19, 0.05);
+        noise = 0;
+        scramble = 1;
+        thread = DefaultThread();
+    }
+    /**
+     * 设置点数为2^s
+     * @param s 规模
+     */
+    void SetScale(int s) { node = 1 << s; }
+    /**
+     * 设置四个象限的概率，会自动归一化
+     * @param a 左上
+     * @param b 右上
+     * @param c 左下
+     * @param d 右下
+     */
+    void SetProbability(double a, double b, double c, double d) {
+        if (a < 0 || b < 0 || c < 0 || d < 0 || a + b + c + d <= 0) {
+            FailGen("probabilities must be non-negative and not all zero.\n");
+        }
+        double sum = a + b + c + d;
+        prob[0] = a / sum;
+        prob[1] = b / sum;
+        prob[2] = c / sum;
+        prob[3] = d / sum;
+    }
+    /**
+     * 设置每层概率的扰动幅度，每层的概率乘上[1-x,1+x]中的随机数后归一化
+     * @param x 扰动幅度，范围[0,1)
+     */
+    void SetNoise(double x) { noise = x; }
+    /**
+     * 设置是否打乱点的编号，不打乱时编号小的点度数大
+     */
+    void SetScramble(bool f) { scramble = f; }
+    /**
+     * 设置线程数
+     * @param t 线程数，默认为硬件支持的并发数
+     */
+    void SetThread(int t) { thread = std::max(1, t); }
+    /**
+     * 不保证连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        JudgeLimits();
+        if (noise < 0 || noise >= 1) {
+            FailGen("noise must in [0,1).\n");
+        }
+        if (node == 1 && !self_loop && side > 0) {
+            FailGen("number of edges must be 0 when there is only one node.\n");
+        }
+        // b和c都为0时每一层都选对角线上的象限，只能生成自环
+        if (!self_loop && side > 0 && prob[1] == 0 && prob[2] == 0) {
+            FailGen("b and c can not both be 0 without self loops.\n");
+        }
+        int scale = 0;
+        while ((1LL << scale) < node) {
+            scale++;
+        }
+        // 每层的前缀概率，乘上2^21取整
+        std::vector<std::array<unsigned long long, 3>> level(scale);
+        for (int k = 0; k < scale; k++) {
+            double q[4], sum = 0;
+            for (int i = 0; i < 4; i++) {
+                q[i] = prob[i] * (noise > 0 ? thread_rnd->next(1 - noise, 1 + noise) : 1);
+                sum += q[i];
+            }
+            double w = (1 << 21) / sum;
+            level[k] = {(unsigned long long)(q[0] * w), (unsigned long long)((q[0] + q[1]) * w),
+                        (unsigned long long)((q[0] + q[1] + q[2]) * w)};
+        }
+        std::vector<unsigned long long> key(side);
+        Generate(key, 0, side, scale, level);
+        if (!multiply_edge) {
+            for (int round = 0;; round++) {
+                ParallelSort(key, thread);
+                key.erase(std::unique(key.begin(), key.end()), key.end());
+                if (key.size() >= (size_t)side) {
+                    break;
+                }
+                size_t need = side - key.size();
+                // 接近完全图时剩下的点对概率很小，补生成几轮后改为从补集中均匀选
+                if (round == 4) {
+                    Complement(key, need);
+                    break;
+                }
+                size_t more = need + need / 4 + 16;
+                key.resize(key.size() + more);
+                Generate(key, key.size() - more, more, scale, level);
+            }
+            // 多出来的边随机删去
+            for (int i = 0; i < side; i++) {
+                std::swap(key[i], key[thread_rnd->next((long long)i, (long long)key.size() - 1)]);
+            }
+            key.resize(side);
+        }
+        std::vector<int> p;
+        if (scramble) {
+            p = thread_rnd->perm(node, 0);
+        }
+        edge.resize(side);
+        int chunk = (side + CHUNK - 1) / CHUNK;
+        std::vector<long long> seed(chunk);
+        for (int i = 0; i < chunk; i++) {
+            seed[i] = thread_rnd->next(1LL << 62);
+        }
+        ParallelFor(chunk, thread, [&](int t) {
+            random_t rng;
+            rng.setSeed(seed[t]);
+            int r = std::min(side, (t + 1) * CHUNK);
+            for (int i = t * CHUNK; i < r; i++) {
+                int u = key[i] >> 32, v = key[i] & 0xffffffffULL;
+                if (scramble) {
+                    u = p[u];
+                    v = p[v];
+                }
+                if (!direction && rng.next(2)) {
+                    std::swap(u, v);
+                }
+                edge[i] = {u + begin_node, v + begin_node};
+            }
+        });
+        ShuffleEdge();
+    }
+};
+/**
+ * 随机平面图，先生成极大平面图(三角剖分)，边数不足3n-6时再删边
+ * @note 在边长为range的直角三角形内随机取整点，三角形的三个顶点也是图中的点，按坐标排序后扫描三角剖分
+ * @note 生成的边在对应的坐标下不相交，可以用GetPoint获取每个点的坐标
+ * @note 强制设self_loop=0,multiply_edge=0
+ */
+class PlanarGraph : public Graph {
+   private:
+    long long range;                                     // 坐标范围
+    std::vector<std::pair<long long, long long>> point;  // 每个点的坐标
+    virtual void JudgeUpper() {
+        if (node < 3) {
+            FailGen("node must greater than or equal to 3.\n");
+        }
+        if (side > 3LL * node - 6) {
+            FailGen("number of edges must less than or equal to %lld.\n", 3LL * node - 6);
+        }
+    }
+    static long long Cross(const std::pair<long long, long long>& o, const std::pair<long long, long long>& a,
+                           const std::pair<long long, long long>& b) {
+        return (a.first - o.first) * (b.second - o.second) - (a.second - o.second) * (b.first - o.first);
+    }
+
+   public:
+    /**
+     * @param n 结点数，不能少于3
+     * @param m 边数，不能超过3n-6
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证连通
+     * @note range=1e9 坐标范围
+     */
+    PlanarGraph(int n = 3, int m = 0) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        range = 1e9;
+    }
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 设置边数为3n-6，即生成极大平面图
+     */
+    void SetTriangulation() { side = 3 * node - 6; }
+    /**
+     * 设置坐标范围，所有点都在(0,0),(c,0),(0,c)构成的三角形内
+     * @param c 坐标范围，范围[6,2e9]，且(c-1)/2的平方不能少于n-3
+     */
+    void SetRange(long long c) { range = c; }
+    /**
+     * 获取每个点的坐标，第i个元素为点i+begin_node的坐标
+     */
+    std::vector<std::pair<long long, long long>> GetPoint() { return point; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        JudgeLimits();
+        long long h = (range - 1) / 2;
+        if (range < 6 || range > 2000000000LL || h * h < node - 3) {
+            FailGen("range is too small or too large for %d nodes.\n", node);
+        }
+        // 按(x,y)排序的点：(0,0),(0,c),内部的点,(c,0)，内部的点在[1,h]^2中，严格在三角形内部
+        std::vector<std::pair<long long, long long>> pt;
+        pt.reserve(node);
+        pt.push_back({0, 0});
+        pt.push_back({0, range});
+        for (unsigned long long x : SampleSorted(h * h, node - 3)) {
+            pt.push_back({(long long)(x / h) + 1, (long long)(x % h) + 1});
+        }
+        pt.push_back({range, 0});
+        // 凸包按逆时针存成双向链表，新点在所有旧点的右边(或正上方)，向两边删去可见的凸包边
+        std::vector<int> nxt(node), prv(node);
+        std::vector<std::pair<int, int>> tri;
+        tri.reserve(3 * node - 6);
+        tri.push_back({0, 1});
+        tri.push_back({1, 2});
+        tri.push_back({0, 2});
+        nxt[0] = 2, nxt[2] = 1, nxt[1] = 0;
+        prv[2] = 0, prv[1] = 2, prv[0] = 1;
+        for (int i = 3; i < node; i++) {
+            int l = i - 1, r = i - 1;
+            tri.push_back({i - 1, i});
+            while (Cross(pt[r], pt[nxt[r]], pt[i]) < 0) {
+                r = nxt[r];
+                tri.push_back({r, i});
+            }
+            while (Cross(pt[prv[l]], pt[l], pt[i]) < 0) {
+                l = prv[l];
+                tri.push_back({l, i});
+            }
+            nxt[l] = i, prv[i] = l;
+            nxt[i] = r, prv[r] = i;
+        }
+        // 删边：需要连通时先用随机顺序的Kruskal保留一棵生成树
+        int keep = 0;
+        Shuffle(tri.begin(), tri.end());
+        if (connect) {
+            std::vector<int> f(node);
+            for (int i = 0; i < node; i++) {
+                f[i] = i;
+            }
+            auto find = [&](int x) {
+                while (f[x] != x) {
+                    x = f[x] = f[f[x]];
+                }
+                return x;
+            };
+            for (size_t i = 0; i < tri.size(); i++) {
+                int u = find(tri[i].first), v = find(tri[i].second);
+                if (u != v) {
+                    f[u] = v;
+                    std::swap(tri[keep++], tri[i]);
+                }
+            }
+            Shuffle(tri.begin() + keep, tri.end());
+        }
+        tri.resize(side);
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        point.resize(node);
+        for (int i = 0; i < node; i++) {
+            point[p[i]] = pt[i];
+        }
+        Builder build(edge, begin_node, direction);
+        build.Reserve(side);
+        for (auto x : tri) {
+            build.Edge(p[x.first], p[x.second]);
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 指定强连通分量的有向图，缩点后是一个DAG
+ * @note 每个强连通分量内部是一个随机的有向环，分量按随机的拓扑序排列
+ * @note 其余的边从所有不改变分量结构的点对(同一分量内部，或从拓扑序小的分量连向大的分量)中无放回地均匀抽取
+ * @note connect=1时保证弱连通；component=1时生成强连通图
+ * @note 强制设direction=1,multiply_edge=0
+ */
+class SCCGraph : public Graph {
+   private:
+    int component;                    // 强连通分量个数，-1表示随机
+    std::vector<int> component_size;  // 指定的每个分量大小，为空表示随机
+    std::vector<int> belong;          // 每个点所属的分量，按拓扑序编号
+    virtual void JudgeUpper() {}
+    std::vector<int> RandComponentSize() {
+        int k = component == -1 ? thread_rnd->next(1, node) : component;
+        if (!component_size.empty()) {
+            long long sum = 0;
+            for (int x : component_size) {
+                if (x < 1) {
+                    FailGen("size of each component must be a positive integer.\n");
+                }
+                sum += x;
+            }
+            if (sum != node) {
+                FailGen("sum of component sizes must be equal to %d.\n", node);
+            }
+            return component_size;
+        }
+        if (k < 1 || k > node) {
+            FailGen("restriction of the component is [1,%d], but found %d.\n", node, k);
+        }
+        std::vector<int> size(k, 1);
+        for (int i = k; i < node; i++) {
+            size[thread_rnd->next(k)]++;
+        }
+        return size;
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param k 强连通分量个数，不指定的话随机
+     * @note 其余参数默认如下：
+     * @note direction=1 有向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=0 不保证弱连通
+     */
+    SCCGraph(int n = 1, int m = 0, int k = -1) {
+        node = n;
+        side = m;
+        direction = 1;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 0;
+        component = k;
+    }
+    /**
+     * 强制有向图，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 设置强连通分量个数
+     * @param k 分量个数，-1表示随机
+     */
+    void SetComponent(int k) {
+        component = k;
+        component_size.clear();
+    }
+    /**
+     * 设置每个强连通分量的大小，分量个数同时设为a.size()
+     * @param a 每个分量的大小，和应为结点数
+     */
+    void SetComponentSize(std::vector<int> a) {
+        component_size = a;
+        component = a.size();
+    }
+    /**
+     * 设置每个强连通分量的大小为随机
+     */
+    void ResetComponentSize() { component_size.clear(); }
+    /**
+     * 获取每个点所属的分量，第i个元素为点i+begin_node的分量编号，分量按拓扑序从0开始编号
+     */
+    std::vector<int> GetComponent() { return belong; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        JudgeLimits();
+        std::vector<int> size = RandComponentSize();
+        int k = size.size();
+        std::vector<int> start(k + 1, 0);
+        for (int i = 0; i < k; i++) {
+            start[i + 1] = start[i] + size[i];
+        }
+        // 结构边：分量内的环，连通时再加一棵把分量连起来的树，边的端点用点序表示
+        std::vector<std::pair<int, int>> skeleton, ban;
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i]; size[i] > 1 && u < start[i + 1]; u++) {
+                skeleton.push_back({u, u + 1 < start[i + 1] ? u + 1 : start[i]});
+            }
+        }
+        if (connect) {
+            for (int i = 1; i < k; i++) {
+                int j = thread_rnd->next(i);
+                skeleton.push_back({start[j] + thread_rnd->next(size[j]), start[i] + thread_rnd->next(size[i])});
+            }
+        }
+        std::vector<int> low(node), high(node, node);
+        long long total = 0;
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i]; u < start[i + 1]; u++) {
+                low[u] = start[i];
+                total += node - start[i] - !self_loop;
+                if (!self_loop) {
+                    ban.push_back({u, u});
+                }
+            }
+        }
+        if (side < (long long)skeleton.size() || side > total) {
+            FailGen("number of edges must in [%d,%lld] under the restrictions of components.\n",
+                    (int)skeleton.size(), total);
+        }
+        ban.insert(ban.end(), skeleton.begin(), skeleton.end());
+        SortPair(ban, node);
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        belong.resize(node);
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i]; u < start[i + 1]; u++) {
+                belong[p[u]] = i;
+            }
+        }
+        edge.reserve(side);
+        for (auto x : skeleton) {
+            edge.push_back({p[x.first] + begin_node, p[x.second] + begin_node});
+        }
+        for (auto x : SampleRange(low, high, ban, side - skeleton.size())) {
+            edge.push_back({p[x.first] + begin_node, p[x.second] + begin_node});
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 指定桥和割点个数的无向连通图
+ * @note 图由若干个块沿一棵随机的块割树拼起来：桥是只有一条边的块，其余的块是随机环加上弦，都是点双连通的
+ * @note 桥恰好有bridge条，割点恰好有cut个；bridge=0,cut=0时生成点双连通图，bridge=0时生成边双连通图
+ * @note 弦从所有块内不在环上的点对中无放回地均匀抽取
+ * @note 强制设direction=0,multiply_edge=0,self_loop=0,connect=1
+ */
+class BlockCutGraph : public Graph {
+   private:
+    int bridge;                                    // 桥的条数
+    int cut;                                       // 割点个数，-1表示随机
+    int block;                                     // 不是桥的块的个数，-1表示随机
+    std::vector<int> cut_node;                     // 生成的割点
+    std::vector<std::pair<int, int>> bridge_edge;  // 生成的桥
+    virtual void JudgeUpper() {}
+    /**
+     * 有q个不是桥的块时是否有解
+     */
+    bool Feasible(int q) {
+        int k = bridge + q;
+        long long x = (long long)side - bridge;
+        long long nc = (long long)node + q - 1 - bridge;  // 不是桥的块的点数之和
+        if (cut != -1 && (k == 1 ? cut != 0 : cut < 1 || cut > k - 1)) {
+            return false;
+        }
+        if (q == 0) {
+            return nc == 0 && x == 0;
+        }
+        if (nc < 3LL * q || x < nc) {
+            return false;
+        }
+        long long s = nc - 3LL * (q - 1);
+        return x <= 3LL * (q - 1) + s * (s - 1) / 2;
+    }
+    /**
+     * 把nc个点随机分成q个至少3个点的块，块内弦的总容量至少为chord
+     */
+    std::vector<int> RandBlockSize(int q, long long nc, long long chord) {
+        long long extra = nc - 3LL * q;
+        for (int times = 0; times < 10; times++) {
+            std::vector<int> size;
+            long long last = -1, capacity = 0;
+            for (long long x : SampleSorted(extra + q - 1, q - 1)) {
+                size.push_back(3 + x - last - 1);
+                last = x;
+            }
+            size.push_back(3 + extra + q - 1 - last - 1);
+            for (long long s : size) {
+                capacity += s * (s - 3) / 2;
+            }
+            if (capacity >= chord) {
+                return size;
+            }
+        }
+        // 边很多时把点集中到一个块里
+        std::vector<int> size(q, 3);
+        size[thread_rnd->next(q)] += extra;
+        return size;
+    }
+
+   public:
+    /**
+     * @param n 结点数
+     * @param m 边数
+     * @param b 桥的条数
+     * @param c 割点个数，-1表示随机
+     * @note 其余参数默认如下：
+     * @note direction=0 无向图
+     * @note multiply_edge=0 无重边
+     * @note self_loop=0 无自环
+     * @note connect=1 保证连通
+     */
+    BlockCutGraph(int n = 1, int m = 0, int b = 0, int c = -1) {
+        node = n;
+        side = m;
+        direction = 0;
+        multiply_edge = 0;
+        self_loop = 0;
+        connect = 1;
+        bridge = b;
+        cut = c;
+        block = -1;
+    }
+    /**
+     * 强制无向图，禁用函数
+     */
+    void SetDirection(bool f) = delete;
+    /**
+     * 强制无重边，禁用函数
+     */
+    void SetMultiplyEdge(bool f) = delete;
+    /**
+     * 强制无自环，禁用函数
+     */
+    void SetSelfLoop(bool f) = delete;
+    /**
+     * 强制连通，禁用函数
+     */
+    void SetConnect(bool f) = delete;
+    /**
+     * 设置桥的条数
+     * @param b 桥的条数，范围为[0,n-1]
+     */
+    void SetBridge(int b) { bridge = b; }
+    /**
+     * 设置割点个数
+     * @param c 割点个数，-1表示随机
+     */
+    void SetCut(int c) { cut = c; }
+    /**
+     * 设置不是桥的块(点双连通分量)的个数
+     * @param q 块的个数，-1表示随机
+     */
+    void SetBlock(int q) { block = q; }
+    /**
+     * 获取生成的割点
+     */
+    std::vector<int> GetCutNode() { return cut_node; }
+    /**
+     * 获取生成的桥，和GetEdge()中的方向一致
+     */
+    std::vector<std::pair<int, int>> GetBridgeEdge() { return bridge_edge; }
+    /**
+     * 生成图
+     */
+    void GenGraph() {
+        edge.clear();
+        cut_node.clear();
+        bridge_edge.clear();
+        if (node <= 0) {
+            FailGen("node must be a positive integer.\n");
+        }
+        JudgeLimits();
+        if (bridge < 0 || bridge > node - 1) {
+            FailGen("restriction of the bridge is [0,%d].\n", node - 1);
+        }
+        if (node == 1) {
+            if (side != 0 || cut > 0) {
+                FailGen("a graph with only one node has no edges and no cut nodes.\n");
+            }
+            ShuffleEdge();
+            return;
+        }
+        std::vector<int> possible;
+        for (int q = 0; 2LL * q <= node - 1 - bridge; q++) {
+            if ((block == -1 || block == q) && Feasible(q)) {
+                possible.push_back(q);
+            }
+        }
+        if (possible.empty()) {
+            FailGen("no graph satisfies the restrictions of bridges, cut nodes and blocks.\n");
+        }
+        int q = thread_rnd->any(possible), k = bridge + q;
+        int c = cut != -1 ? cut : (k == 1 ? 0 : thread_rnd->next(1, k - 1));
+        long long nc = (long long)node + q - 1 - bridge, chord = side - bridge - nc;
+        std::vector<int> size(bridge, 2);
+        if (q > 0) {
+            std::vector<int> rest = RandBlockSize(q, nc, chord);
+            size.insert(size.end(), rest.begin(), rest.end());
+        }
+        Shuffle(size.begin(), size.end());
+        // 除第一个块外，每个块和之前的某个点共用一个点；恰好c次共用的是新的割点
+        std::vector<char> fresh(k, 0);
+        if (k > 1) {
+            fresh[1] = 1;
+            std::vector<int> order = thread_rnd->perm(k - 1, 1);
+            for (int i = 0, j = 0; j < c - 1; i++) {
+                if (order[i] != 1) {
+                    fresh[order[i]] = 1;
+                    j++;
+                }
+            }
+        }
+        std::vector<int> start(k + 1), vert, free, cuts;
+        vert.reserve(node + k - 1);
+        free.reserve(node);
+        for (int i = 0, id = 0; i < k; i++) {
+            start[i] = vert.size();
+            if (i > 0) {
+                if (fresh[i]) {
+                    int t = thread_rnd->next((int)free.size());
+                    cuts.push_back(free[t]);
+                    free[t] = free.back();
+                    free.pop_back();
+                    vert.push_back(cuts.back());
+                } else {
+                    vert.push_back(thread_rnd->any(cuts));
+                }
+            }
+            while ((int)vert.size() - start[i] < size[i]) {
+                free.push_back(id);
+                vert.push_back(id++);
+            }
+        }
+        start[k] = vert.size();
+        std::vector<int> p = thread_rnd->perm(node, 0);
+        for (int& v : vert) {
+            v = p[v];
+        }
+        for (int v : cuts) {
+            cut_node.push_back(p[v] + begin_node);
+        }
+        unsigned long long total = 0, base = 0;
+        for (int i = 0; i < k; i++) {
+            if (size[i] > 2) {
+                total += (unsigned long long)size[i] * (size[i] - 3) / 2;
+            }
+        }
+        std::vector<unsigned long long> pick = SampleSorted(total, chord);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(side);
+        size_t t = 0;
+        for (int i = 0; i < k; i++) {
+            int s = size[i], l = start[i];
+            if (s == 2) {
+                build.Edge(vert[l], vert[l + 1]);
+                bridge_edge.push_back(edge.back());
+                continue;
+            }
+            Shuffle(vert.begin() + l, vert.begin() + l + s);
+            build.Cycle(vert, l, l + s);
+            // 块内第x个点和第y个点(x+2<=y，去掉首尾)之间的弦按(x,y)的字典序编号
+            unsigned long long capacity = (unsigned long long)s * (s - 3) / 2, row = 0, len = s - 3;
+            for (int x = 0; t < pick.size() && pick[t] < base + capacity; t++) {
+                unsigned long long r = pick[t] - base;
+                while (r >= row + len) {
+                    row += len;
+                    x++;
+                    len = s - x - 2;
+                }
+                build.Edge(vert[l + x], vert[l + x + 2 + (r - row)]);
+            }
+            base += capacity;
+        }
+        ShuffleEdge();
+    }
+};
+/**
+ * 指定度数序列的简单图
+ * @note 无向图先用Erdős–Gallai定理判断是否可图，再用按度数分桶的Havel–Hakimi算法构造
+ * @note 有向图先用Fulkerson–Chen–Anstee定理判断，再用Kleitman–Wang算法构造
+ * @note 构造出的图再做swap次随机的双边交换打乱，交换不改变每个点的度数
+ * @note 强制设multiply_edge=0,self_loop=0,connect=0
+ */
+class DegreeGraph : public Graph {
+   private:
+    std::vector<int> degree;      // 无向图时为每个点的度数，有向图时为出度
+    std::vector<int> in_degree;   // 有向图时为每个点的入度
+    long long swap = -1;          // 双边交换的尝试次数，-1表示和边数相同
+    virtual void JudgeUpper() {}
+    /**
+     * Erdős–Gallai：d从大到小排序后，对每个k有d_1+...+d_k<=k(k-1)+sum(min(d_i,k),i>k)
+     */
+    bool IsGraphic() {
+        std::vector<int> cnt(node, 0), d;
+        long long sum = 0;
+        for (int x : degree) {
+            if (x < 0 || x > node - 1) {
+                return false;
+            }
+            cnt[x]++;
+            sum += x;
+        }
+        if (sum % 2) {
+            return false;
+        }
+        d.reserve(node);
+        for (int x = node - 1; x >= 0; x--) {
+            d.insert(d.end(), cnt[x], x);
+        }
+        std::vector<long long> pre(node + 1, 0);
+        for (int i = 0; i < node; i++) {
+            pre[i + 1] = pre[i] + d[i];
+        }
+        // big为度数至少为k的点数
+        for (int k = 1, big = node; k <= node; k++) {
+            while (big > 0 && d[big - 1] < k) {
+                big--;
+            }
+            long long right = big > k ? (long long)(big - k) * k + pre[node] - pre[big] : pre[node] - pre[k];
+            if (pre[k] > (long long)k * (k - 1) + right) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * Fulkerson–Chen–Anstee：按(出度,入度)从大到小排序后，对每个k有
+     * a_1+...+a_k<=sum(min(b_i,k-1),i<=k)+sum(min(b_i,k),i>k)
+     */
+    bool IsDigraphic() {
+        std::vector<int> order(node), cnt(node + 1, 0);
+        long long sum = 0;
+        for (int i = 0; i < node; i++) {
+            if (degree[i] < 0 || degree[i] > node - 1 || in_degree[i] < 0 || in_degree[i] > node - 1) {
+                return false;
+            }
+            sum += degree[i] - in_degree[i];
+            order[i] = i;
+            cnt[in_degree[i]]++;
+        }
+        if (sum != 0) {
+            return false;
+        }
+        std::sort(order.begin(), order.end(), [&](int x, int y) {
+            return std::make_pair(degree[x], in_degree[x]) > std::make_pair(degree[y], in_degree[y]);
+        });
+        // all为所有点的min(b_i,k)之和，less为入度小于k的点数
+        // 前k个点中入度至少为k的点数用树状数组维护
+        std::vector<int> tree(node + 1, 0);
+        long long left = 0, all = 0;
+        int less = 0;
+        for (int k = 1; k <= node; k++) {
+            less += cnt[k - 1];
+            all += node - less;
+            int b = in_degree[order[k - 1]];
+            for (int x = node - b; x <= node; x += x & -x) {
+                tree[x]++;
+            }
+            int ge = 0;
+            for (int x = node - k; x > 0; x -= x & -x) {
+                ge += tree[x];
+            }
+            left += degree[order[k - 1]];
+            if (left > all - ge) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * 按度数分桶的Havel–Hakimi：每次取剩余度数最小的点，连向剩余度数最大的那些点
+     */
+    void HavelHakimi(std::vector<std::pair<int, int>>& g) {
+        // bucket[x]为剩余度数为x的点，非空的桶按度数串成链表，0和node为哨兵
+        std::vector<std::vector<int>> bucket(node);
+        std::vector<int> rest(degree), pos(node), up(node + 1), down(node + 1), pick;
+        auto link = [&](int x, int y) {
+            down[x] = down[y];
+            up[x] = y;
+            up[down[y]] = x;
+            down[y] = x;
+        };
+        auto remove = [&](int u) {
+            auto& b = bucket[rest[u]];
+            pos[b.back()] = pos[u];
+            b[pos[u]] = b.back();
+            b.pop_back();
+            if (b.empty()) {
+                down[up[rest[u]]] = down[rest[u]];
+                up[down[rest[u]]] = up[rest[u]];
+            }
+        };
+        down[node] = 0;
+        up[0] = node;
+        for (int u = 0; u < node; u++) {
+            if (rest[u] > 0) {
+                pos[u] = bucket[rest[u]].size();
+                bucket[rest[u]].push_back(u);
             }
         }
-        u += begin_node;
-        v += begin_node;
-        if (direction == true) {
-            edge.push_back({u, v});
-        } else {
-            if (rnd.next(2)) {
-                edge.push_back({u, v});
-            } else {
-                edge.push_back({v, u});
+        for (int x = node - 1, last = node; x > 0; x--) {
+            if (!bucket[x].empty()) {
+                link(x, last);
+                last = x;
             }
         }
-    }
-    virtual void JudgeUpper() {
-        long long limit;
-        if (!multiply_edge) {
-            limit = (long long)node * (long long)(node - 1) / 2;
-            if (direction) {
-                limit *= 2;
+        while (up[0] != node) {
+            int x = up[0], v = bucket[x].back();
+            remove(v);
+            pick.clear();
+            for (int y = down[node]; (int)pick.size() < x && y != 0; y = down[y]) {
+                for (int i = (int)bucket[y].size() - 1; i >= 0 && (int)pick.size() < x; i--) {
+                    pick.push_back(bucket[y][i]);
+                }
             }
-            if (self_loop) {
-                limit += node;
+            if ((int)pick.size() < x) {
+                FailGen("the degree sequence is not graphic.\n");
             }
-            if (side > limit) {
-                FailGen("number of edges must less than or equal to %lld.\n",
-                        limit);
+            for (int u : pick) {
+                g.push_back({v, u});
+                int y = rest[u];
+                if (y > 1 && bucket[y - 1].empty()) {
+                    link(y - 1, y);
+                }
+                remove(u);
+                if (--rest[u] > 0) {
+                    pos[u] = bucket[y - 1].size();
+                    bucket[y - 1].push_back(u);
+                }
             }
         }
     }
-    virtual void JudgeLimits() {
-        if (side < 0) {
-            FailGen("number of edges must be a non-negative integer.\n");
-        }
-        if (side > edge_limit) {
-            FailGen(
-                "number of edges must less than or equal to %d, or you can change "
-                "the edge_limit.\n",
-                edge_limit);
+    /**
+     * Kleitman–Wang：依次取每个出度非零的点，连向剩余入度最大的那些点，入度相同时优先连剩余出度大的点
+     */
+    void KleitmanWang(std::vector<std::pair<int, int>>& g) {
+        std::vector<int> out(degree), in(in_degree), pick;
+        std::set<std::tuple<int, int, int>> order;
+        for (int u = 0; u < node; u++) {
+            if (in[u] > 0) {
+                order.insert({-in[u], -out[u], u});
+            }
         }
-        JudgeUpper();
-        if (connect) {
-            if (side < node - 1) {
-                FailGen("number of edges must greater than or equal to %d.\n",
-                        node - 1);
+        for (int v = 0; v < node; v++) {
+            if (out[v] == 0) {
+                continue;
+            }
+            if (in[v] > 0) {
+                order.erase({-in[v], -out[v], v});
+            }
+            pick.clear();
+            for (auto it = order.begin(); it != order.end() && (int)pick.size() < out[v]; it++) {
+                pick.push_back(std::get<2>(*it));
+            }
+            if ((int)pick.size() < out[v]) {
+                FailGen("the degree sequences are not digraphic.\n");
+            }
+            out[v] = 0;
+            if (in[v] > 0) {
+                order.insert({-in[v], 0, v});
+            }
+            for (int u : pick) {
+                g.push_back({v, u});
+                order.erase({-in[u], -out[u], u});
+                if (--in[u] > 0) {
+                    order.insert({-in[u], -out[u], u});
+                }
             }
         }
     }
 
    public:
     /**
-     * @param n 结点数
-     * @param m 边数
+     * @param d 每个点的度数，第i个元素为点i+begin_node的度数
      * @note 其余参数默认如下：
      * @note direction=0 无向图
      * @note multiply_edge=0 无重边
      * @note self_loop=0 无自环
      * @note connect=0 不保证连通
      */
-    Graph(int n = 1, int m = 0) {
-        node = n;
-        side = m;
-        direction = 0;
+    DegreeGraph(std::vector<int> d = {0}) {
         multiply_edge = 0;
         self_loop = 0;
         connect = 0;
+        SetDegree(d);
     }
     /**
-     * 设置结点数
-     * @param n 结点数
+     * 设置无向图的度数序列，点数和边数随之确定
+     * @param d 每个点的度数，第i个元素为点i+begin_node的度数
      */
-    void SetNode(int n) { node = n; }
+    void SetDegree(std::vector<int> d) {
+        degree = d;
+        in_degree.clear();
+        direction = 0;
+        node = d.size();
+        long long sum = 0;
+        for (int x : d) {
+            sum += x;
+        }
+        side = sum / 2;
+    }
     /**
-     * 设置边数
-     * @param m 边数
+     * 设置有向图的出度和入度序列，点数和边数随之确定
+     * @param out 每个点的出度
+     * @param in 每个点的入度，长度应和out相同
      */
-    void SetSide(int m) { side = m; }
+    void SetDegree(std::vector<int> out, std::vector<int> in) {
+        if (out.size() != in.size()) {
+            FailGen("out-degree and in-degree sequences must have the same length.\n");
+        }
+        degree = out;
+        in_degree = in;
+        direction = 1;
+        node = out.size();
+        long long sum = 0;
+        for (int x : out) {
+            sum += x;
+        }
+        side = sum;
+    }
     /**
-     * 设置有向/无向图
-     * @param f 0：无向;1：有向;默认无向图
-     */
-    void SetDirection(bool f) { direction = f; }
-    /** Refactor for C++
-     * 设置能不能存在重边
-     * @param f 0：无重边;1：有重边;默认无重边
+     * 设置双边交换的尝试次数
+     * @param k 尝试次数，-1表示和边数相同，越多越接近均匀随机
      */
-    void SetMultiplyEdge(bool f) { multiply_edge = f; }
+    void SetSwap(long long k) { swap = k; }
     /**
-     * 设置能不能存在自环
-     * @param f 0：无自环;1：有自环;默认无自环
+     * 点数由度数序列决定，禁用函数
      */
-    void SetSelfLoop(bool f) { self_loop = f; }
+    void SetNode(int n) = delete;
     /**
-     * 设置保不保证一定连通
-     * @param f 0：不保证一定连通;1：保证一定连通;默认不保证一定连通
+     * 边数由度数序列决定，禁用函数
      */
-    void SetConnect(bool f) { connect = f; }
+    void SetSide(int m) = delete;
     /**
-     * 获取边
+     * 由SetDegree决定有向/无向，禁用函数
      */
-    std::vector<std::pair<int, int>> GetEdge() { return edge; }
+    void SetDirection(bool f) = delete;
     /**
-     * 设置点数上限
+     * 强制无重边，禁用函数
      */
-    void SetNodeLimit(unsigned int n) {
-        node_limit = n;
-    }
+    void SetMultiplyEdge(bool f) = delete;
     /**
-     * 设置边数上限
+     * 强制无自环，禁用函数
      */
-    void SetEdgeLimit(unsigned int m) {
-        edge_limit = m;
-    }
+    void SetSelfLoop(bool f) = delete;
     /**
-     * 设置第一个结点的编号
+     * 不保证连通，禁用函数
      */
-    void SetBeginNode(int n) {
-        begin_node = n;
-    }
+    void SetConnect(bool f) = delete;
     /**
      * 生成图
      */
     void GenGraph() {
         edge.clear();
-        e.clear();
+        if (node <= 0) {
+            FailGen("node must be a positive integer.\n");
+        }
         JudgeLimits();
-        int m = side;
-        if (connect) {
-            m -= node - 1;
-            Tree tree(node);
-            tree.GenTree();
-            edge = tree.GetEdge();
-            if (!multiply_edge) {
-                for (auto x : edge) {
-                    e[x] = 1;
+        std::vector<std::pair<int, int>> g;
+        g.reserve(side);
+        if (direction) {
+            if (!IsDigraphic()) {
+                FailGen("the degree sequences are not digraphic.\n");
+            }
+            KleitmanWang(g);
+        } else {
+            if (!IsGraphic()) {
+                FailGen("the degree sequence is not graphic.\n");
+            }
+            HavelHakimi(g);
+        }
+        int m = g.size();
+        long long times = swap == -1 ? m : swap;
+        if (m >= 2 && times > 0) {
+            HashSet exist(m);
+            for (auto x : g) {
+                exist.Insert(Key(x.first, x.second));
+            }
+            // (a,b),(c,d)换成(a,d),(c,b)
+            for (long long t = 0; t < times; t++) {
+                int i = thread_rnd->next(m), j = thread_rnd->next(m);
+                int a = g[i].first, b = g[i].second, c = g[j].first, d = g[j].second;
+                if (!direction && thread_rnd->next(2)) {
+                    std::swap(c, d);
                 }
+                if (i == j || a == d || c == b || exist.Count(Key(a, d)) || exist.Count(Key(c, b))) {
+                    continue;
+                }
+                exist.Erase(Key(a, b));
+                exist.Erase(Key(c, d));
+                exist.Insert(Key(a, d));
+                exist.Insert(Key(c, b));
+                g[i] = {a, d};
+                g[j] = {c, b};
             }
         }
-        while (m--) {
-            int u, v;
-            do {
-                u = rnd.next(node);
-                v = rnd.next(node);
-            } while (JudgeSelfLoop(u, v) || JudgeMultiplyEdge(u, v));
-            AddEdge(u, v);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(m);
+        for (auto x : g) {
+            build.Edge(x.first, x.second);
         }
-        shuffle(edge.begin(), edge.end());
+        ShuffleEdge();
     }
 };
 /**
- * 二分图
- * @note 强制设direction=0,self_loop=0
+ * 恰好有k个连通分量的图，有向图为弱连通分量
+ * @note 先在O(n)内把点分成k个分量，每个分量内是一棵随机树，其余的边只连在同一分量内部
+ * @note 无重边时其余的边从同一分量内不在树上的点对中无放回地均匀抽取，不做拒绝；有重边时按点对数选分量后有放回地抽取
+ * @note 强制设connect=0
  */
-class BipartiteGraph : public Graph {
-   private:
-    int left, right;  // 左部，右部大小
-    bool set_left;    // 是否要随机左部大小
-    void RandLeft() {
-        if (set_left == true) {
-            right = node - left;
-            if (left < 0 || right < 0) {
-                FailGen("left part or right part must greater than or equal to 0.\n");
+class ComponentGraph : public Graph {
+   protected:
+    int component;                         // 连通分量个数，-1表示随机
+    std::vector<int> component_size;       // 指定的每个分量大小，为空表示随机
+    std::vector<double> component_weight;  // 每个分量分到多余点的权重，为空表示等概率
+    std::vector<int> belong;               // 每个点所属的分量
+    bool forest = false;                   // 是否为森林，此时边数为n-k
+    virtual void JudgeUpper() {}
+    std::vector<int> RandComponentSize() {
+        if (!component_size.empty()) {
+            long long sum = 0;
+            for (int x : component_size) {
+                if (x < 1) {
+                    FailGen("size of each component must be a positive integer.\n");
+                }
+                sum += x;
             }
-            return;
-        }
-        int l = 0, r = node / 2, limit;
-        if (multiply_edge == 0) {
-            if (side > r * (node - r)) {
-                FailGen("number of edges must less than or equal to %d.\n", r * (node - r));
+            if (sum != node) {
+                FailGen("sum of component sizes must be equal to %d.\n", node);
             }
-            while (l <= r) {
-                int mid = (l + r) / 2;
-                if (mid * (node - mid) < side) {
-                    l = mid + 1;
-                } else {
-                    limit = r;
-                    r = mid - 1;
-                }
+            return component_size;
+        }
+        int k = component;
+        if (k == -1) {
+            k = thread_rnd->next(forest ? 1 : std::max(1, node - side), node);
+        }
+        if (k < 1 || k > node) {
+            FailGen("restriction of the component is [1,%d], but found %d.\n", node, k);
+        }
+        // 每个分量先分一个点，其余的点按权重独立地分到各个分量
+        std::vector<int> size(k, 1);
+        if (component_weight.empty()) {
+            for (int i = k; i < node; i++) {
+                size[thread_rnd->next(k)]++;
             }
         } else {
-            limit = 1;
-        }
-        left = rnd.next(limit, node / 2);
-        right = node - left;
-    }
-    virtual void JudgeUpper() {
-        long long limit;
-        if (!multiply_edge) {
-            limit = (long long)left * (long long)right;
-            if (side > limit) {
-                FailGen("number of edges must less than or equal to %lld.\n",
-                        limit);
+            AliasTable table(component_weight);
+            for (int i = k; i < node; i++) {
+                size[table.Next()]++;
             }
         }
+        return size;
     }
 
    public:
     /**
      * @param n 结点数
-     * @param m 边数
-     * @param l 左部大小，右部=点数-左部，不设采用随机值
+     * @param m 边数，至少为n-k
+     * @param k 连通分量个数，不指定的话随机
      * @note 其余参数默认如下：
      * @note direction=0 无向图
      * @note multiply_edge=0 无重边
      * @note self_loop=0 无自环
-     * @note connect=0 不保证连通
      */
-    BipartiteGraph(int n = 1, int m = 0, int l = -1) {
+    ComponentGraph(int n = 1, int m = 0, int k = -1) {
         node = n;
         side = m;
         direction = 0;
         multiply_edge = 0;
         self_loop = 0;
         connect = 0;
-        if (l != -1) {
-            set_left = true;
-            left = l;
-        }
+        component = k;
     }
     /**
-     * 强制无向图，禁用函数
+     * 分量个数由参数决定，禁用函数
      */
-    void SetDirection(bool f) = delete;
+    void SetConnect(bool f) = delete;
     /**
-     * 强制无自环，禁用函数
+     * 设置连通分量个数
+     * @param k 分量个数，-1表示随机
      */
-    void SetSelfLoop(bool f) = delete;
+    void SetComponent(int k) {
+        component = k;
+        component_size.clear();
+        component_weight.clear();
+    }
     /**
-     * 设置左部大小
-     * @param l 左部大小
+     * 设置每个连通分量的大小，分量个数同时设为a.size()
+     * @param a 每个分量的大小，和应为结点数
      */
-    void SetLeft(int l) {
-        left = l;
-        set_left = true;
+    void SetComponentSize(std::vector<int> a) {
+        component_size = a;
+        component = a.size();
     }
     /**
-     * 生成图
+     * 设置分量大小的分布：每个分量先有一个点，其余每个点以正比于w[i]的概率分到第i个分量，分量个数同时设为w.size()
+     * @param w 每个分量的权重，不能全为0，比如w[i]=pow(i+1,-2)时分量大小近似幂律分布
      */
-    void GenGraph() {
-        edge.clear();
-        e.clear();
-        RandLeft();
-        JudgeLimits();
-        std::vector<int> part[2];
-        std::vector<int> p = rnd.perm(node, 0);
-        for (int i = 0; i < left; i++) {
-            part[0].push_back(p[i]);
-        }
-        for (int i = left; i < node; i++) {
-            part[1].push_back(p[i]);
-        }
-        int m = side;
-        if (connect) {
-            m -= node - 1;
-            std::vector<int> degree[2];
-            degree[0].resize(left, 1);
-            degree[1].resize(right, 1);
-            for (int i = left; i < node - 1; i++) {
-                degree[0][rnd.next(left)]++;
-            }
-            for (int i = right; i < node - 1; i++) {
-                degree[1][rnd.next(right)]++;
-            }
-            int f = 0, d[2] = {node - 1, node - 1};
-            while (d[0] + d[1] > 0) {
-                for (int i = 0; i < (f == 0 ? left : right); i++) {
-                    if (degree[f][i] == 1) {
-                        if (d[f] == 1) {
-                            for (int j = 0; j < (f == 0 ? right : left); j++) {
-                                if (degree[f ^ 1][j] == 1) {
-                                    AddEdge(part[f][i], part[f ^ 1][j]);
-                                    d[0]--;
-                                    d[1]--;
-                                    degree[f][i]--;
-                                    degree[f ^ 1][j]--;
-                                }
-                            }
-                        } else {
-                            int j;
-                            do {
-                                j = rnd.next(f == 0 ? right : left);
-                            } while (degree[f ^ 1][j] < 2);
-                            AddEdge(part[f][i], part[f ^ 1][j]);
-                            d[0]--;
-                            d[1]--;
-                            degree[f][i]--;
-                            degree[f ^ 1][j]--;
-                        }
-                    }
-                }
-                f ^= 1;
-            }
-        }
-        while (m--) {
-            int u, v;
-            do {
-                u = rnd.any(part[0]);
-                v = rnd.any(part[1]);
-            } while (JudgeMultiplyEdge(u, v));
-            AddEdge(u, v);
-        }
-        shuffle(edge.begin(), edge.end());
+    void SetComponentWeight(std::vector<double> w) {
+        component_weight = w;
+        component = w.size();
+        component_size.clear();
     }
-};
-/**
- * DAG
- * @note 强制设self_loop=0,direction=1
- */
-class DAG : public Graph {
-   public:
     /**
-     * @param n 结点数
-     * @param m 边数
-     * @note 其余参数默认如下：
-     * @note direction=1 有向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=0 不保证连通
+     * 设置每个连通分量的大小为随机，各分量等概率地分到多余的点
      */
-    DAG(int n = 1, int m = 0) {
-        node = n;
-        side = m;
-        direction = 1;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 0;
+    void ResetComponentSize() {
+        component_size.clear();
+        component_weight.clear();
     }
     /**
-     * 强制无向图,禁用函数
+     * 获取每个点所属的分量，第i个元素为点i+begin_node的分量编号，从0开始
      */
-    void SetDirection(bool f) = delete;
+    std::vector<int> GetComponent() { return belong; }
     /**
-     * 强制无自环,禁用函数
+     * 在Graph::Verify的基础上检查连通分量个数
      */
-    void SetSelfLoop(bool f) = delete;
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        int k = 0;
+        for (int x : belong) {
+            k = std::max(k, x + 1);
+        }
+        if (res.empty() && Verifier(node, edge, begin_node).Components() != k) {
+            res = "number of components is not " + std::to_string(k);
+        }
+        return res;
+    }
     /**
      * 生成图
      */
     void GenGraph() {
         edge.clear();
-        e.clear();
-        JudgeLimits();
-        std::vector<int> p(node);
-        int m = side;
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+        std::vector<int> size = RandComponentSize();
+        int k = size.size();
+        if (forest) {
+            side = node - k;
+        }
+        JudgeLimits();
+        if (side < node - k) {
+            FailGen("number of edges must greater than or equal to %d for %d components.\n", node - k, k);
         }
-        shuffle(p.begin(), p.end());
-        if (connect) {
-            m = std::max(0, m - (node - 1));
-            for (int i = 1; i < node; i++) {
-                int f = rnd.next(i);
-                AddEdge(p[f], p[i]);
+        std::vector<int> start(k + 1, 0);
+        for (int i = 0; i < k; i++) {
+            start[i + 1] = start[i] + size[i];
+        }
+        // 树边：分量内的每个点连向分量内排在它前面的随机一个点，边的端点用点序表示
+        std::vector<std::pair<int, int>> skeleton, ban;
+        skeleton.reserve(node - k);
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i] + 1; u < start[i + 1]; u++) {
+                skeleton.push_back({start[i] + thread_rnd->next(u - start[i]), u});
             }
         }
-        while (m--) {
-            int u, v;
-            do {
-                u = rnd.next(node);
-                v = rnd.next(node);
-                if (u > v) {
-                    std::swap(u, v);
+        RandPerm(p, node);
+        belong.resize(node);
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i]; u < start[i + 1]; u++) {
+                belong[p[u]] = i;
+            }
+        }
+        long long extra = side - (node - k);
+        Builder build(edge, begin_node, direction);
+        build.Reserve(side);
+        for (auto x : skeleton) {
+            build.Edge(p[x.first], p[x.second]);
+        }
+        if (multiply_edge) {
+            std::vector<double> w(k);
+            bool any = false;
+            for (int i = 0; i < k; i++) {
+                w[i] = (double)size[i] * (size[i] - !self_loop);
+                any |= w[i] > 0;
+            }
+            if (extra > 0 && !any) {
+                FailGen("number of edges must be equal to %d when every component has one node.\n", node - k);
+            }
+            AliasTable table(any ? w : std::vector<double>{1});
+            while (extra-- > 0) {
+                int i = table.Next();
+                int u = thread_rnd->next(size[i]), v = thread_rnd->next(size[i] - !self_loop);
+                if (!self_loop && v >= u) {
+                    v++;
+                }
+                build.Edge(p[start[i] + u], p[start[i] + v]);
+            }
+            ShuffleEdge();
+            return;
+        }
+        // 每个点可以连向同一分量内的点，无向时只连向点序更大的点
+        std::vector<int> low(node), high(node);
+        long long total = 0;
+        for (int i = 0; i < k; i++) {
+            for (int u = start[i]; u < start[i + 1]; u++) {
+                low[u] = direction ? start[i] : u + !self_loop;
+                high[u] = start[i + 1];
+                total += high[u] - low[u];
+                if (direction && !self_loop) {
+                    ban.push_back({u, u});
                 }
-            } while (JudgeSelfLoop(p[u], p[v]) || JudgeMultiplyEdge(p[u], p[v]));
-            AddEdge(p[u], p[v]);
+            }
         }
+        ban.insert(ban.end(), skeleton.begin(), skeleton.end());
+        total -= ban.size();
+        if (extra > total) {
+            FailGen("number of edges must less than or equal to %lld under the restrictions of components.\n",
+                    node - k + total);
+        }
+        SortPair(ban, node);
+        for (auto x : SampleRange(low, high, ban, extra)) {
+            build.Edge(p[x.first], p[x.second]);
+        }
+        ShuffleEdge();
     }
 };
 /**
- * 环图
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,side=n
+ * 有k棵树的随机森林，即边数为n-k的ComponentGraph
+ * @note 每棵树的形态和Tree相同；direction=1时每条边从父亲指向儿子
+ * @note 强制设multiply_edge=0,self_loop=0,connect=0
  */
-class CycleGraph : public Graph {
+class Forest : public ComponentGraph {
    public:
     /**
      * @param n 结点数
+     * @param k 树的个数，不指定的话随机
      * @note 其余参数默认如下：
-     * @note side=n 边数固定
-     * @note direction=0 无向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * @note direction=0 无向
      */
-    CycleGraph(int n = 1) {
+    Forest(int n = 1, int k = -1) {
         node = n;
-        side = n;
+        side = 0;
         direction = 0;
         multiply_edge = 0;
         self_loop = 0;
-        connect = 1;
-    }
-    /**
-     * 设置点数
-     * @param n 节点数
-     */
-    void SetNode(int n) {
-        node = n;
-        side = n;
+        connect = 0;
+        component = k;
+        forest = true;
     }
     /**
-     * 强制边数等于点数，禁用函数
+     * 边数为n-k，禁用函数
      */
     void SetSide(int m) = delete;
     /**
@@ -716,74 +5291,137 @@ class CycleGraph : public Graph {
      * 强制无自环，禁用函数
      */
     void SetSelfLoop(bool f) = delete;
+};
+/**
+ * 动态图的操作序列：在初始图上依次加边、删边、询问，用于动态连通性、在线最小生成树等题目
+ * @note 初始图的生成方式和Graph相同，用Output输出；操作用OutputOperation输出，
+ * @note 每行为"1 u v"(加边，有边权时为"1 u v w")、"2 u v"(删边)或"3 u v"(询问)
+ * @note 加的边一定当前不存在，删的边一定当前存在，任何时刻都没有重边和自环
+ * @note connect=1时初始图连通，并且它的一棵生成树上的边不会被删除，所以任何时刻都连通
+ * @note 强制设multiply_edge=0,self_loop=0
+ */
+class DynamicGraph : public Graph {
+   public:
+    enum OperationType { OP_ADD = 1, OP_REMOVE = 2, OP_QUERY = 3 };
+    struct Operation {
+        int type;    // 操作类型，见OperationType
+        int u, v;    // 端点(已经加上begin_node)
+        long long w;  // 加边时的边权，没有边权时为0
+    };
+
+   protected:
+    int operation;                // 操作数
+    double ratio[3] = {1, 1, 1};  // 加边、删边、询问的比例
+    bool op_weight = false;       // 加边操作是否带边权
+    std::vector<Operation> op;    // 操作序列
+    EdgeSet alive;                // 当前存在并且可以删除的边，键见Key
+    HashSet fixed;                // connect=1时不能删除的生成树边
+    std::vector<int> dsu;         // 找生成树用的并查集
+    int Find(int x) {
+        while (dsu[x] != x) {
+            x = dsu[x] = dsu[dsu[x]];
+        }
+        return x;
+    }
     /**
-     * 强制连通，禁用函数
-     */
-    void SetConnect(bool f) = delete;
-    /**
-     * 根据点集生成图
-     * @param a 点集
-     * @attention 如果结点集合有重复点则会产生错误
+     * 把初始图的边放进集合，connect=1时用并查集找出一棵生成树作为不能删除的边
      */
-    void GenGraph(std::vector<int> a) {
-        edge.clear();
-        e.clear();
-        int n = a.size();
-        for (int i = 1; i < n; i++) {
-            AddEdge(a[i], a[i - 1]);
+    void InitSet() {
+        alive.Reset(edge.size() + operation);
+        fixed.Reset(connect ? node : 0);
+        if (connect) {
+            dsu.resize(node);
+            for (int i = 0; i < node; i++) {
+                dsu[i] = i;
+            }
         }
-        if (JudgeSelfLoop(a[0], a[n - 1]) == 0 && JudgeMultiplyEdge(a[0], a[n - 1]) == 0) {
-            AddEdge(a[0], a[n - 1]);
+        for (auto& e : edge) {
+            int u = e.first - begin_node, v = e.second - begin_node;
+            if (connect && Find(u) != Find(v)) {
+                dsu[Find(u)] = Find(v);
+                fixed.Insert(Key(u, v));
+            } else {
+                alive.Insert(Key(u, v));
+            }
         }
     }
-    /**
-     * 根据结点数生成图
-     */
-    void GenGraph() {
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+    void GenOperation() {
+        if (operation < 0) {
+            FailGen("number of operations must be a non-negative integer.\n");
+        }
+        if (!(ratio[0] >= 0 && ratio[1] >= 0 && ratio[2] >= 0)) {
+            FailGen("ratio of operations must be non-negative.\n");
+        }
+        InitSet();
+        op_weight = weight_type != 0;
+        op.resize(operation);
+        long long total = direction ? (long long)node * (node - 1) : (long long)node * (node - 1) / 2;
+        for (int i = 0; i < operation; i++) {
+            // 不能进行的操作比例视为0
+            double add = (long long)(alive.Size() + fixed.Size()) < total ? ratio[0] : 0;
+            double remove = alive.Size() ? ratio[1] : 0;
+            double sum = add + remove + ratio[2];
+            if (sum <= 0) {
+                FailGen("no operation is possible at step %d.\n", i + 1);
+            }
+            double r = thread_rnd->next(sum);
+            Operation& o = op[i];
+            if (r < add) {
+                // 拒绝采样，期望尝试次数为总点对数除以不存在的边数
+                unsigned long long key;
+                do {
+                    o.u = thread_rnd->next(node);
+                    o.v = thread_rnd->next(node);
+                    key = Key(o.u, o.v);
+                } while (o.u == o.v || alive.Count(key) || fixed.Count(key));
+                alive.Insert(key);
+                o.type = OP_ADD;
+            } else if (r < add + remove) {
+                unsigned long long key = alive.Random();
+                alive.Erase(key);
+                o.u = key / node;
+                o.v = key % node;
+                if (!direction && thread_rnd->next(2)) {
+                    std::swap(o.u, o.v);
+                }
+                o.type = OP_REMOVE;
+            } else {
+                o.u = thread_rnd->next(node);
+                o.v = node == 1 ? o.u : thread_rnd->next(node - 1);
+                if (node > 1 && o.v >= o.u) {
+                    o.v++;
+                }
+                o.type = OP_QUERY;
+            }
+            o.u += begin_node;
+            o.v += begin_node;
+            o.w = o.type == OP_ADD && op_weight ? RandWeight(o.u, o.v) : 0;
         }
-        shuffle(p.begin(), p.end());
-        GenGraph(p);
-        shuffle(edge.begin(), edge.end());
     }
-};
-/**
- * 轮图
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,side=2n-2
- */
-class WheelGraph : public Graph {
+
    public:
     /**
      * @param n 结点数
+     * @param m 初始图的边数
+     * @param q 操作数
      * @note 其余参数默认如下：
-     * @note side=2*n-2 边数固定
      * @note direction=0 无向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * @note connect=0 不保证连通
+     * @note 加边、删边、询问的比例为1:1:1
      */
-    WheelGraph(int n = 1) {
-        node = n;
-        side = 2 * n - 2;
-        direction = 0;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
-    }
+    DynamicGraph(int n = 1, int m = 0, int q = 0) : Graph(n, m), operation(q) {}
     /**
-     * 设置结点数
-     * @param n 结点数
+     * 设置操作数
      */
-    void SetNode(int n) {
-        node = n;
-        side = 2 * n - 2;
-    }
+    void SetOperation(int q) { operation = q; }
     /**
-     * 强制边数等于2*node-2，禁用函数
+     * 设置加边、删边、询问的比例，某种操作当前不能进行时(图已满或没有可删的边)按比例在其余操作中选
      */
-    void SetSide(int m) = delete;
+    void SetRatio(double add, double remove, double query) {
+        ratio[0] = add;
+        ratio[1] = remove;
+        ratio[2] = query;
+    }
     /**
      * 强制无重边，禁用函数
      */
@@ -793,474 +5431,890 @@ class WheelGraph : public Graph {
      */
     void SetSelfLoop(bool f) = delete;
     /**
-     * 强制连通，禁用函数
+     * 获取操作序列
      */
-    void SetConnect(bool f) = delete;
+    std::vector<Operation> GetOperation() { return op; }
     /**
-     * 根据指定支配点和其余点生成图
-     * @param v 指定点
-     * @param p 其余点
-     * @attention 如果结点集合有重复点则会产生错误
+     * 在Graph::Verify的基础上重放操作序列，检查加的边不存在、删的边存在、端点在范围内
      */
-    void GenGraph(int v, std::vector<int> p) {
-        edge.clear();
-        e.clear();
-        CycleGraph cycle;
-        cycle.GenGraph(p);
-        edge = cycle.GetEdge();
-        for (int i = 0; i < p.size(); i++) {
-            AddEdge(v, p[i]);
+    virtual std::string Verify() {
+        std::string res = Graph::Verify();
+        if (!res.empty() || op.empty()) {
+            return res;
+        }
+        HashSet now(edge.size() + op.size());
+        for (auto& e : edge) {
+            now.Insert(Key(e.first - begin_node, e.second - begin_node));
+        }
+        for (auto& o : op) {
+            int u = o.u - begin_node, v = o.v - begin_node;
+            if (u < 0 || u >= node || v < 0 || v >= node) {
+                return "operation out of range";
+            }
+            if (o.type == OP_ADD && (u == v || !now.Insert(Key(u, v)))) {
+                return "added edge already exists";
+            }
+            if (o.type == OP_REMOVE && !now.Erase(Key(u, v))) {
+                return "removed edge does not exist";
+            }
         }
-        shuffle(edge.begin(), edge.end());
+        return "";
     }
     /**
-     * 根据指定点生成图，支配点随机
-     * @param p 点集，不可为空
-     * @attention 如果结点集合有重复点则会产生错误
+     * 生成初始图和操作序列
      */
-    void GenGraph(std::vector<int> p) {
-        shuffle(p.begin(), p.end());
-        std::vector<int> pre(p.begin() + 1, p.end());
-        GenGraph(p[0], pre);
+    void GenGraph() {
+        op.clear();
+        Graph::GenGraph();
+        GenOperation();
+        DebugVerify();
     }
     /**
-     * 根据点数生成图
+     * 输出操作序列，每行一个操作
      */
-    void GenGraph() {
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+    void OutputOperation(FILE* out = stdout) {
+        Writer w(out);
+        OutputOperation(w);
+    }
+    /**
+     * 输出操作序列到w
+     */
+    void OutputOperation(Writer& w) {
+        for (auto& o : op) {
+            w.WriteInt(o.type);
+            w.WriteChar(' ');
+            w.WriteInt(o.u);
+            w.WriteChar(' ');
+            w.WriteInt(o.v);
+            if (o.type == OP_ADD && op_weight) {
+                w.WriteChar(' ');
+                w.WriteInt(o.w);
+            }
+            w.WriteChar('\n');
         }
-        GenGraph(p);
     }
 };
 /**
- * 网格图
- * @note 强制设connect=1,self_loop=0
+ * 从已有的数据文件读入或从生成器接过来的图，可以原地做重新编号、改方向、细分、并图、加噪声边等变换后输出
+ * @note 每个变换都是一遍线性扫描，直接改写边集，不为单条边分配内存
  */
-class GridGraph : public Graph {
+class LoadedGraph : public EdgeList {
    protected:
-    long long CountSide(int x, int y) {
-        long long xl = (long long)x;
-        long long yl = (long long)y;
-        long long sum = xl * (yl - 1) + yl * (xl - 1) - 2 * ((yl - node % yl) % yl);
-        if (direction == 1) {
-            sum *= 2;
+    int node = 0;                                // 结点数
+    int begin_node = 1;                          // 结点开始编号
+    bool direction = 0;                          // 是否有向，决定加噪声边的去重和线图、补图、幂图的语义
+    std::vector<int> perm;                       // 重新编号用的排列
+    std::vector<int> low, high;                  // 加噪声边时每个点可连的范围
+    std::vector<std::pair<int, int>> ban;        // 加噪声边和求补图时已有的边
+    std::vector<int> start, adj;                 // 代数运算用的邻接表(CSR)
+    std::vector<std::pair<int, int>> out;        // 代数运算的结果，写完后和边集交换
+    std::vector<long long> out_weight;           // 代数运算结果的边权
+    /**
+     * 把已有的边(去掉begin_node)排序去重后放进ban，无向时按(小,大)存并去掉自环，有向时加上所有自环；
+     * 同时把每个点可连的范围放进low和high：无向时为[u+1,n)，有向时为[0,n)
+     */
+    void BuildBan() {
+        ban.clear();
+        for (auto& e : edge) {
+            int u = e.first - begin_node, v = e.second - begin_node;
+            if (direction) {
+                ban.push_back({u, v});
+            } else if (u != v) {
+                ban.push_back({std::min(u, v), std::max(u, v)});
+            }
         }
-        return sum;
-    }
-    virtual void JudgeUpper() {
-        long long limit = 0;
-        if (!multiply_edge) {
-            int x = sqrt(node), y = (node + x - 1) / x;
-            limit = CountSide(x, y);
+        low.resize(node);
+        high.assign(node, node);
+        for (int u = 0; u < node; u++) {
+            low[u] = direction ? 0 : u + 1;
             if (direction) {
-                limit *= 2;
+                ban.push_back({u, u});
             }
-            if (side > limit) {
-                FailGen("number of edges must less than or equal to %lld.\n",
-                        limit);
+        }
+        SortPair(ban, node);
+        ban.erase(std::unique(ban.begin(), ban.end()), ban.end());
+    }
+    /**
+     * 把边集建成邻接表，点u的表为adj[start[u],start[u+1])；无向时每条边在两端各出现一次，自环只出现一次
+     * @param id 为true时表中存边的编号，否则存另一个端点
+     */
+    void BuildAdj(bool id) {
+        start.assign(node + 1, 0);
+        for (auto& e : edge) {
+            start[e.first - begin_node + 1]++;
+            if (!direction && e.first != e.second) {
+                start[e.second - begin_node + 1]++;
+            }
+        }
+        for (int u = 0; u < node; u++) {
+            start[u + 1] += start[u];
+        }
+        adj.resize(start[node]);
+        std::vector<int> pos(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < edge.size(); i++) {
+            int u = edge[i].first - begin_node, v = edge[i].second - begin_node;
+            adj[pos[u]++] = id ? i : v;
+            if (!direction && u != v) {
+                adj[pos[v]++] = id ? i : u;
             }
         }
     }
-
-   public:
     /**
-     * @param n 结点数
-     * @param m 边数
-     * @note 其余参数默认如下：
-     * @note direction=0 无向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * 用out和out_weight替换边集和边权，点数变为n
      */
-    GridGraph(int n = 1, int m = 0) {
+    void Replace(long long n) {
+        edge.swap(out);
+        weight.swap(out_weight);
         node = n;
-        side = m;
-        direction = 0;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
     }
     /**
-     * 强制无自环，禁用函数
+     * 检查运算结果的规模
      */
-    void SetSelfLoop(bool f) = delete;
+    void CheckSize(long long n, long long m) {
+        if (n > INT_MAX - std::max(begin_node, 0) || m > INT_MAX) {
+            FailGen("result is too large: %lld nodes, %lld edges.\n", n, m);
+        }
+    }
     /**
-     * 强制连通，禁用函数
+     * 跳过空白后读一个整数，读到end为止
+     * @return 读到整数时为true，只剩空白时为false
      */
-    void SetConnect(bool f) = delete;
+    static bool ParseInt(const char*& p, const char* end, long long& x) {
+        while (p < end && (unsigned char)*p <= ' ') {
+            p++;
+        }
+        if (p == end) {
+            return false;
+        }
+        bool neg = *p == '-';
+        p += neg;
+        const char* s = p;
+        unsigned long long y = 0;
+        for (unsigned d; p < end && (d = *p - '0') < 10; p++) {
+            y = y * 10 + d;
+        }
+        if (p == s || p - s > 19 || y > (unsigned long long)LLONG_MAX + neg || (p < end && (unsigned char)*p > ' ')) {
+            FailGen("invalid integer near \"%.*s\".\n", (int)std::min<ptrdiff_t>(20, end - s + neg), s - neg);
+        }
+        x = neg ? -(long long)y : (long long)y;
+        return true;
+    }
     /**
-     * 生成图
+     * [p,end)中第一行的整数个数
      */
-    void GenGraph() {
-        edge.clear();
-        e.clear();
-        JudgeLimits();
-        int m = side, column, row;
-        std::vector<int> p(node);
-        int d[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-        if (multiply_edge == 0) {
-            std::pair<int, int> max = {0, 0};
-            std::vector<int> possible;
-            for (int i = 1; i <= node; i++) {
-                int x = i, y = (node + i - 1) / i;
-                long long w = CountSide(y, x);
-                if (direction == 1) {
-                    w *= 2;
-                }
-                if (w > max.first) {
-                    max = {w, i};
-                }
-                if (w >= side) {
-                    possible.push_back(i);
-                }
-            }
-            if (possible.size() == 0) {
-                m = max.first;
-                row = max.second;
-                column = (node + row - 1) / row;
-            } else {
-                row = rnd.any(possible);
-                column = (node + row - 1) / row;
-                m = CountSide(column, row);
-            }
+    static int CountLine(const char* p, const char* end) {
+        const char* e = std::find(p, end, '\n');
+        int k = 0;
+        for (long long x; ParseInt(p, e, x);) {
+            k++;
+        }
+        return k;
+    }
+    /**
+     * 解析整个文件的内容
+     */
+    void Parse(const char* p, const char* end) {
+        long long n = 0, m = 0;
+        int head = CountLine(p, end);
+        if (head != 1 && head != 2) {
+            FailGen("the first line must be \"n m\" or \"n\".\n");
+        }
+        ParseInt(p, end, n);
+        if (head == 2) {
+            ParseInt(p, end, m);
         } else {
-            row = rnd.next(1, node);
-            column = (node + row - 1) / row;
+            m = n - 1;
         }
-        m = std::max(0, m - (node - 1));
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+        if (n < 1 || n > INT_MAX || m < 0 || m > INT_MAX) {
+            FailGen("invalid header: n=%lld, m=%lld.\n", n, m);
         }
-        shuffle(p.begin(), p.end());
-        for (int i = 0; i < row; i++) {
-            for (int j = 1; j < column; j++) {
-                int x = i * column + j, y = x - 1;
-                if (x >= node) continue;
-                if (i % 2 == 0) {
-                    AddEdge(p[y], p[x]);
-                } else {
-                    AddEdge(p[x], p[y]);
-                }
+        node = n;
+        while (p < end && *p != '\n') {
+            p++;
+        }
+        // 每条边至少占"u v\n"四个字节，先检查再分配，避免错误的头部申请过多内存
+        if (m * 4 > end - p) {
+            FailGen("expected %lld edges, but the file is too short.\n", m);
+        }
+        // 跳过空行后按第一条边的整数个数判断有没有边权
+        const char* q = p;
+        while (q < end && (unsigned char)*q <= ' ') {
+            q++;
+        }
+        bool weighted = m > 0 && CountLine(q, end) == 3;
+        edge.resize(m);
+        weight.resize(weighted ? m : 0);
+        long long low = begin_node, high = begin_node + n - 1;
+        for (long long i = 0; i < m; i++) {
+            long long u, v;
+            if (!ParseInt(p, end, u) || !ParseInt(p, end, v) || (weighted && !ParseInt(p, end, weight[i]))) {
+                FailGen("expected %lld edges, found %lld.\n", m, i);
             }
-            int x = i * column, y = (i + 1) * column;
-            if (x < node && y < node) {
-                AddEdge(p[x], p[y]);
+            if (u < low || u > high || v < low || v > high) {
+                FailGen("edge %lld (%lld,%lld) is out of [%lld,%lld].\n", i + 1, u, v, low, high);
             }
+            edge[i] = {(int)u, (int)v};
         }
-        while (m--) {
-            int pos, k, px, py, nxt;
-            do {
-                pos = rnd.next(node);
-                k = rnd.next(4);
-                px = pos / column + d[k][0];
-                py = pos % column + d[k][1];
-                nxt = px * column + py;
-            } while (px < 0 || px >= row || py < 0 || py >= column || nxt >= node || JudgeMultiplyEdge(p[pos], p[nxt]));
-            AddEdge(p[pos], p[nxt]);
+        long long extra;
+        if (ParseInt(p, end, extra)) {
+            FailGen("unexpected data after %lld edges.\n", m);
+        }
+    }
+
+   public:
+    /**
+     * @param b 文件中结点的开始编号
+     */
+    LoadedGraph(int b = 1) : begin_node(b) {}
+    /**
+     * 读入数据文件：第一行为"n m"(只有"n"时m=n-1)，之后m行每行一条边"u v"或"u v w"，
+     * 有没有边权由第一条边的整数个数决定；文件映射到内存后直接解析，不经过cin或scanf
+     * @param file 输入文件
+     * @note 结点编号必须在[begin_node,begin_node+n-1]内，读入前用SetBeginNode设置文件的编号方式
+     */
+    void Load(const std::string& file) {
+#ifndef _WIN32
+        int fd = open(file.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd == -1 || fstat(fd, &st) != 0) {
+            if (fd != -1) {
+                close(fd);
+            }
+            FailGen("cannot open %s.\n", file.c_str());
+        }
+        size_t size = st.st_size;
+        if (size == 0) {
+            close(fd);
+            Parse(nullptr, nullptr);
+            return;
+        }
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            FailGen("cannot map %s.\n", file.c_str());
+        }
+        madvise(data, size, MADV_SEQUENTIAL);
+        try {
+            Parse((const char*)data, (const char*)data + size);
+        } catch (...) {
+            munmap(data, size);
+            throw;
+        }
+        munmap(data, size);
+#else
+        FILE* in = fopen(file.c_str(), "rb");
+        if (in == nullptr) {
+            FailGen("cannot open %s.\n", file.c_str());
+        }
+        std::vector<char> data;
+        char buf[1 << 16];
+        for (size_t k; (k = fread(buf, 1, sizeof(buf), in)) > 0;) {
+            data.insert(data.end(), buf, buf + k);
+        }
+        fclose(in);
+        Parse(data.data(), data.data() + data.size());
+#endif
+    }
+    /**
+     * 获取结点数
+     */
+    int GetNode() { return node; }
+    /**
+     * 设置结点开始编号，已经读入的边跟着重新编号
+     * @param b 结点开始编号
+     */
+    void SetBeginNode(int b) {
+        int d = b - begin_node;
+        for (auto& e : edge) {
+            e.first += d;
+            e.second += d;
         }
-        shuffle(edge.begin(), edge.end());
+        begin_node = b;
     }
-};
-/**
- * 基环树
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=0,side=n
- */
-class PseudoTree : public Graph {
-   public:
     /**
-     * @param n 结点数
-     * @attention n>=3,否则会产生问题
-     * @note 其余参数默认如下：
-     * @note side=n 边数固定
-     * @note direction=0 无向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * 设置是否有向，读入和接过来的图默认按无向处理
+     * @note 影响AddNoise的去重：无向时(u,v)和(v,u)算同一条边
+     * @note 影响LineGraph、Complement、Power：无向时按无向图的定义计算，有向时沿边的方向计算
      */
-    PseudoTree(int n = 3) {
-        node = n;
-        side = n;
-        direction = 0;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
-    }
+    void SetDirection(bool d) { direction = d; }
     /**
-     * 设置点数
-     * @param n 点数
+     * 随机打乱边的顺序，边权跟着边一起移动
      */
-    void SetNode(int n) {
+    void Shuffle() { ShuffleEdge(true); }
+    /**
+     * 接过生成器g的边和边权，g的边集变为空，不复制
+     * @param g 已经生成好的生成器
+     * @param n g的结点数
+     * @param b g的结点开始编号
+     */
+    void Take(EdgeList& g, int n, int b = 1) {
+        if (n < 1) {
+            FailGen("node must be a positive integer.\n");
+        }
+        edge.swap(EdgeOf(g));
+        weight.swap(WeightOf(g));
+        EdgeOf(g).clear();
+        WeightOf(g).clear();
         node = n;
-        side = node;
+        begin_node = b;
     }
     /**
-     * 强制边数等于点数，禁用函数
+     * 随机重新编号
      */
-    void SetSide(int m) = delete;
+    void Relabel() {
+        RandPerm(perm, node);
+        Relabel(perm);
+    }
     /**
-     * 强制无向，禁用函数
+     * 按给定的排列重新编号，编号为begin_node+i的点变为begin_node+p[i]
+     * @param p [0,n)的排列
      */
-    void SetDirection(bool f) = delete;
+    void Relabel(const std::vector<int>& p) {
+        if ((int)p.size() != node) {
+            FailGen("size of the permutation must be %d.\n", node);
+        }
+        if (&p != &perm) {
+            std::vector<bool> seen(node);
+            for (int x : p) {
+                if (x < 0 || x >= node || seen[x]) {
+                    FailGen("p must be a permutation of [0,%d).\n", node);
+                }
+                seen[x] = true;
+            }
+        }
+        for (auto& e : edge) {
+            e.first = p[e.first - begin_node] + begin_node;
+            e.second = p[e.second - begin_node] + begin_node;
+        }
+    }
     /**
-     * 强制无重边，禁用函数
+     * 每条边独立地以1/2的概率反向
      */
-    void SetMultiplyEdge(bool f) = delete;
+    void Reorient() {
+        unsigned long long bits = 0;
+        for (size_t i = 0; i < edge.size(); i++) {
+            // 一个62位随机数供62条边使用
+            if (i % 62 == 0) {
+                bits = thread_rnd->next(1LL << 62);
+            }
+            if (bits & 1) {
+                std::swap(edge[i].first, edge[i].second);
+            }
+            bits >>= 1;
+        }
+    }
     /**
-     * 强制无自环，禁用函数
+     * 把每条边细分成k+1条边的链，新增的k*m个点编号接在原有的点之后，边权跟着复制到链上的每条边
+     * @param k 每条边上插入的点数
+     * @note 第i条边(u,v)变成u->x_1->...->x_k->v，x_j=begin_node+n+i*k+j-1；有向时方向不变
      */
-    void SetSelfLoop(bool f) = delete;
+    void Subdivide(int k) {
+        if (k < 0) {
+            FailGen("k must be a non-negative integer.\n");
+        }
+        size_t m = edge.size();
+        if ((long long)node + (long long)m * k > INT_MAX - std::max(begin_node, 0) ||
+            (long long)m * (k + 1) > INT_MAX) {
+            FailGen("graph is too large after subdivision.\n");
+        }
+        // 从后往前展开，第i条边的链占[i*(k+1),(i+1)*(k+1))，不会覆盖还没读的边
+        edge.resize(m * (k + 1));
+        bool weighted = !weight.empty();
+        if (weighted) {
+            weight.resize(m * (k + 1));
+        }
+        for (size_t i = m; i-- > 0;) {
+            auto e = edge[i];
+            long long w = weighted ? weight[i] : 0;
+            int u = e.first, x = begin_node + node + (int)(i * k);
+            for (int j = 0; j <= k; j++) {
+                int v = j < k ? x + j : e.second;
+                edge[i * (k + 1) + j] = {u, v};
+                if (weighted) {
+                    weight[i * (k + 1) + j] = w;
+                }
+                u = v;
+            }
+        }
+        node += m * k;
+    }
     /**
-     * 强制连通，禁用函数
+     * 并上另一个图，它的点编号接在原有的点之后，即编号为b+i的点变为begin_node+n+i
+     * @param g 另一个生成器，可以是自身
+     * @param n g的结点数
+     * @param b g的结点开始编号
+     * @note 两个图都有边时，要么都有边权，要么都没有
      */
-    void SetConnect(bool f) = delete;
+    void Union(EdgeList& g, int n, int b = 1) {
+        auto& e = EdgeOf(g);
+        auto& w = WeightOf(g);
+        if (n < 1 || (long long)node + n > INT_MAX - std::max(begin_node, 0)) {
+            FailGen("invalid node count %d for union.\n", n);
+        }
+        if (!edge.empty() && !e.empty() && weight.empty() != w.empty()) {
+            FailGen("both graphs must be weighted or unweighted.\n");
+        }
+        size_t m = edge.size(), k = e.size();
+        int d = begin_node + node - b;
+        edge.resize(m + k);
+        for (size_t i = 0; i < k; i++) {
+            edge[m + i] = {e[i].first + d, e[i].second + d};
+        }
+        if (!w.empty()) {
+            weight.resize(m + k);
+            std::copy(w.begin(), w.begin() + k, weight.begin() + m);
+        }
+        node += n;
+    }
     /**
-     * 根据指定环大小生成图，如果不传入参数则随机环大小
-     * @param size 环大小
+     * 加入k条随机噪声边：不是自环，和已有的边、和彼此都不重复，在所有这样的边中等概率选取
+     * @param k 噪声边数
+     * @note 有边权时新边的边权按SetWeight等设置的分布生成
      */
-    void GenGraph(int size = -1) {
-        edge.clear();
-        e.clear();
-        if (size == -1) {
-            size = rnd.next(3, node);
+    void AddNoise(long long k) {
+        if (!weight.empty() && weight_type == 0 && !edge.empty()) {
+            FailGen("set the weight distribution for noise edges of a weighted graph.\n");
         }
-        if (size > node || size < 3) {
-            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+        BuildBan();
+        long long total = direction ? (long long)node * node : (long long)node * (node - 1) / 2;
+        total -= ban.size();
+        if (k < 0 || k > total) {
+            FailGen("number of noise edges must be in [0,%lld].\n", total);
         }
-        size = std::min(size, node);
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+        size_t m = edge.size();
+        if (m + k > INT_MAX) {
+            FailGen("too many edges after adding noise.\n");
+        }
+        edge.reserve(m + k);
+        Builder build(edge, begin_node, direction);
+        for (auto x : SampleRange(low, high, ban, k)) {
+            build.Edge(x.first, x.second);
         }
-        shuffle(p.begin(), p.end());
-        CycleGraph cycle;
-        std::vector<int> pre(p.begin(), p.begin() + size);
-        cycle.GenGraph(pre);
-        edge = cycle.GetEdge();
-        for (int i = size; i < node; i++) {
-            int f = rnd.next(i);
-            AddEdge(p[i], p[f]);
+        if (!weight.empty() || (m == 0 && weight_type != 0)) {
+            GenWeight(m);
         }
-        shuffle(edge.begin(), edge.end());
     }
-};
-/**
- * 基环内向树
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=1,side=n
- */
-class PseudoInTree : public PseudoTree {
-   public:
     /**
-     * @param n 结点数
-     * @attention n>=3,否则会产生问题
-     * @note 其余参数默认如下：
-     * @note side=n 边数固定
-     * @note direction=1 有向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * 和另一个图做笛卡尔积，(x,y)的编号为begin_node+x*n+y；(a,y)-(b,y)对应本图的边(a,b)，(x,c)-(x,d)对应g的边(c,d)
+     * @param g 另一个生成器，可以是自身
+     * @param n g的结点数
+     * @param b g的结点开始编号
+     * @note 边权跟着对应的边复制；两个图都有边时，要么都有边权，要么都没有
      */
-    PseudoInTree(int n = 3) {
-        node = n;
-        side = n;
-        direction = 1;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
+    void Product(EdgeList& g, int n, int b = 1) {
+        auto& e = EdgeOf(g);
+        auto& w = WeightOf(g);
+        if (n < 1) {
+            FailGen("node must be a positive integer.\n");
+        }
+        if (!edge.empty() && !e.empty() && weight.empty() != w.empty()) {
+            FailGen("both graphs must be weighted or unweighted.\n");
+        }
+        long long n1 = node, m1 = edge.size(), m2 = e.size();
+        CheckSize(n1 * n, m1 * n + n1 * m2);
+        bool weighted = !weight.empty() || !w.empty();
+        out.resize(m1 * n + n1 * m2);
+        out_weight.resize(weighted ? out.size() : 0);
+        size_t q = 0;
+        for (long long i = 0; i < m1; i++) {
+            int x = (edge[i].first - begin_node) * n + begin_node, z = (edge[i].second - begin_node) * n + begin_node;
+            for (int y = 0; y < n; y++, q++) {
+                out[q] = {x + y, z + y};
+                if (weighted) {
+                    out_weight[q] = weight[i];
+                }
+            }
+        }
+        for (int x = 0; x < n1; x++) {
+            int d = x * n + begin_node - b;
+            for (long long i = 0; i < m2; i++, q++) {
+                out[q] = {e[i].first + d, e[i].second + d};
+                if (weighted) {
+                    out_weight[q] = w[i];
+                }
+            }
+        }
+        Replace(n1 * n);
     }
     /**
-     * 强制有向，禁用函数
+     * 变为线图：第i条边变为编号为begin_node+i的点，无向时有公共端点的两条边相连，有向时u->v连向v->w
+     * @note 边权按SetWeight等设置的分布重新生成，没有设置时没有边权；重边在线图中也对应重边，自环不产生自环
      */
-    void SetDirection(bool f) = delete;
+    void LineGraph() {
+        int m = edge.size();
+        long long total = 0;
+        BuildAdj(true);
+        for (int u = 0; u < node; u++) {
+            long long d = start[u + 1] - start[u];
+            total += direction ? 0 : d * (d - 1) / 2;
+        }
+        if (direction) {
+            for (auto& e : edge) {
+                int v = e.second - begin_node;
+                total += start[v + 1] - start[v] - (e.first == e.second);
+            }
+        }
+        CheckSize(m, total);
+        out.resize(total);
+        size_t q = 0;
+        if (direction) {
+            for (int i = 0; i < m; i++) {
+                int v = edge[i].second - begin_node;
+                for (int k = start[v]; k < start[v + 1]; k++) {
+                    if (adj[k] != i) {
+                        out[q++] = {i + begin_node, adj[k] + begin_node};
+                    }
+                }
+            }
+        } else {
+            for (int u = 0; u < node; u++) {
+                for (int j = start[u]; j < start[u + 1]; j++) {
+                    for (int k = j + 1; k < start[u + 1]; k++) {
+                        out[q++] = {adj[j] + begin_node, adj[k] + begin_node};
+                    }
+                }
+            }
+        }
+        out_weight.clear();
+        Replace(m);
+        GenWeight();
+    }
     /**
-     * 根据指定环大小生成图，如果不传入参数则随机环大小
-     * @param size 环大小
+     * 变为补图：所有不是自环且原来不存在的边，按(u,v)的字典序写入，无向时u<v
+     * @note 先求出补图的边数，直接写入预分配的空间，时间为O(n+m+补图边数)
+     * @note 边权按SetWeight等设置的分布重新生成，没有设置时没有边权
      */
-    void GenGraph(int size = -1) {
-        edge.clear();
-        e.clear();
-        if (size == -1) {
-            size = rnd.next(3, node);
-        }
-        if (size > node || size < 3) {
-            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+    void Complement() {
+        BuildBan();
+        long long total = direction ? (long long)node * node : (long long)node * (node - 1) / 2;
+        total -= ban.size();
+        CheckSize(node, total);
+        out.resize(total);
+        size_t q = 0, s = 0;
+        for (int u = 0; u < node; u++) {
+            int x = u + begin_node, v = low[u] + begin_node;
+            for (; s < ban.size() && ban[s].first == u; s++) {
+                for (int r = ban[s].second + begin_node; v < r; v++) {
+                    out[q++] = {x, v};
+                }
+                v++;
+            }
+            for (int r = node + begin_node; v < r; v++) {
+                out[q++] = {x, v};
+            }
         }
-        size = std::min(size, node);
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
+        out_weight.clear();
+        Replace(node);
+        GenWeight();
+    }
+    /**
+     * 变为k次幂：距离不超过k的两点之间连边，有向时u能在k步内到达v就连u->v
+     * @param k 幂次
+     * @note 对每个点做深度不超过k的BFS，时间为每个点k步内能到达的边数之和；结果没有自环和重边，无向时u<v
+     * @note 边权按SetWeight等设置的分布重新生成，没有设置时没有边权
+     */
+    void Power(int k) {
+        if (k < 1) {
+            FailGen("k must be a positive integer.\n");
         }
-        shuffle(p.begin(), p.end());
-        CycleGraph cycle;
-        cycle.SetDirection(true);
-        std::vector<int> pre(p.begin(), p.begin() + size);
-        cycle.GenGraph(pre);
-        edge = cycle.GetEdge();
-        for (int i = size; i < node; i++) {
-            int f = rnd.next(i);
-            AddEdge(p[i], p[f]);
+        BuildAdj(false);
+        std::vector<int> mark(node, -1), dist(node), queue(node);
+        out.clear();
+        for (int u = 0; u < node; u++) {
+            int head = 0, tail = 0;
+            queue[tail++] = u;
+            mark[u] = u;
+            dist[u] = 0;
+            while (head < tail) {
+                int x = queue[head++];
+                if (dist[x] == k) {
+                    continue;
+                }
+                for (int j = start[x]; j < start[x + 1]; j++) {
+                    int v = adj[j];
+                    if (mark[v] != u) {
+                        mark[v] = u;
+                        dist[v] = dist[x] + 1;
+                        queue[tail++] = v;
+                        if (direction || v > u) {
+                            out.push_back({u + begin_node, v + begin_node});
+                        }
+                    }
+                }
+            }
+            CheckSize(node, out.size());
         }
-        shuffle(edge.begin(), edge.end());
+        out_weight.clear();
+        Replace(node);
+        GenWeight();
     }
 };
 /**
- * 基环外向树
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=1,side=n
+ * 多组数据：在总点数和总边数的预算内随机分配每组的规模，逐组生成后一次性输出整个文件
+ * @note 生成函数里的FailGen或其他异常只让这一组失败，这一组已经写入的内容会被撤销，错误信息输出到stderr
+ * @note 所有组共用一个输出缓冲区；生成器对象定义在生成函数外面重复使用时，它们的边集等缓冲区也会被复用
  */
-class PseudoOutTree : public PseudoTree {
-   public:
+class Batch {
+   private:
+    int test;                                     // 组数
+    long long node_sum;                           // 总点数
+    long long side_sum;                           // 总边数
+    int min_node = 1;                             // 每组至少的点数
+    int large = 0;                                // 大数据的组数
+    double large_share = 0;                       // 大数据的点数占总点数的比例
+    bool print_test = 1;                          // 是否在第一行输出组数
+    std::vector<std::pair<int, long long>> size;  // 每组的点数和边数
+    std::vector<std::string> error;               // 每组的错误信息，成功时为空
+    Writer buffer{nullptr};                       // 整个文件的内容
     /**
-     * @param n 结点数
-     * @attention n>=3,否则会产生问题
-     * @note 其余参数默认如下：
-     * @note side=n 边数固定
-     * @note direction=1 有向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * 把total随机分成k份，每份至少low
      */
-    PseudoOutTree(int n = 3) {
-        node = n;
-        side = n;
-        direction = 1;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
+    std::vector<long long> Split(long long total, int k, long long low) {
+        std::vector<long long> res;
+        if (k == 0) {
+            return res;
+        }
+        long long extra = total - low * k, last = -1;
+        for (long long x : SampleSorted(extra + k - 1, k - 1)) {
+            res.push_back(low + x - last - 1);
+            last = x;
+        }
+        res.push_back(low + extra + k - 1 - last - 1);
+        return res;
+    }
+    void RandSize() {
+        if (test < 1) {
+            FailGen("number of test cases must be a positive integer.\n");
+        }
+        if (large < 0 || large > test) {
+            FailGen("restriction of the large test cases is [0,%d].\n", test);
+        }
+        if (min_node < 1 || node_sum < (long long)min_node * test) {
+            FailGen("sum of nodes must be at least %lld.\n", (long long)std::max(min_node, 1) * test);
+        }
+        // 全是大数据或全是小数据时点数全部给这一类，否则另一类没有组可分，点数会丢失
+        long long big = large == 0 ? 0 : large == test ? node_sum : llround(node_sum * large_share);
+        big = std::max(big, (long long)min_node * large);
+        big = std::min(big, node_sum - (long long)min_node * (test - large));
+        size.clear();
+        for (auto v : {Split(big, large, min_node), Split(node_sum - big, test - large, min_node)}) {
+            for (long long n : v) {
+                if (n > INT_MAX) {
+                    FailGen("number of nodes in one test case is too large.\n");
+                }
+                size.push_back({(int)n, 0});
+            }
+        }
+        Shuffle(size.begin(), size.end());
+        // 第i组的边数为前i组和前i-1组按点数比例分到的边数之差，总和恰好为总边数
+        long long prefix = 0, given = 0;
+        for (auto& x : size) {
+            prefix += x.first;
+            long long upto = prefix == node_sum ? side_sum : (long long)((long double)side_sum * prefix / node_sum);
+            x.second = upto - given;
+            given = upto;
+        }
     }
+
+   public:
     /**
-     * 强制有向，禁用函数
+     * @param t 组数
+     * @param n 总点数
+     * @param m 总边数，按点数的比例分给每组
      */
-    void SetDirection(bool f) = delete;
+    Batch(int t = 1, long long n = 1, long long m = 0) : test(t), node_sum(n), side_sum(m) {}
     /**
-     * 根据指定环大小生成图，如果不传入参数则随机环大小
-     * @param size 环大小
+     * 设置组数
      */
-    void GenGraph(int size = -1) {
-        edge.clear();
-        e.clear();
-        if (size == -1) {
-            size = rnd.next(3, node);
+    void SetTest(int t) { test = t; }
+    /**
+     * 设置总点数
+     */
+    void SetNodeSum(long long n) { node_sum = n; }
+    /**
+     * 设置总边数，每组的边数为总边数乘上这组点数占总点数的比例，取整后总和恰好为总边数
+     */
+    void SetSideSum(long long m) { side_sum = m; }
+    /**
+     * 设置每组至少的点数
+     */
+    void SetMinNode(int n) { min_node = n; }
+    /**
+     * 设置大数据：k组大数据一共占总点数的share，其余的组平分剩下的点数
+     * @param k 大数据的组数
+     * @param share 大数据的点数占总点数的比例，范围为[0,1]
+     */
+    void SetLarge(int k, double share) {
+        if (!(share >= 0 && share <= 1)) {
+            FailGen("restriction of the share is [0,1].\n");
         }
-        if (size > node || size < 3) {
-            FailGen("Cycle size must in [3 , %d], but found %d.\n", node, size);
+        large = k;
+        large_share = share;
+    }
+    /**
+     * 设置是否在第一行输出组数(成功生成的组数)
+     */
+    void SetPrintTest(bool f) { print_test = f; }
+    /**
+     * 获取每组的点数和边数，生成之后有效
+     */
+    std::vector<std::pair<int, long long>> GetSize() { return size; }
+    /**
+     * 获取每组的错误信息，成功的组为空串，生成之后有效
+     */
+    std::vector<std::string> GetError() { return error; }
+    /**
+     * 生成并输出所有组
+     * @param f 生成一组数据的函数，参数为(点数,边数,Writer&)，把这组数据写入Writer
+     * @param out 输出文件
+     * @return 成功生成的组数
+     */
+    template <typename F>
+    int Gen(F f, FILE* out = stdout) {
+        RandSize();
+        error.assign(test, "");
+        buffer.Resize(0);
+        bool old = fail_throw;
+        fail_throw = true;
+        int ok = 0;
+        for (int i = 0; i < test; i++) {
+            size_t mark = buffer.Size();
+            try {
+                f(size[i].first, size[i].second, buffer);
+                ok++;
+            } catch (const std::exception& ex) {
+                error[i] = ex.what();
+            } catch (...) {
+                error[i] = "unknown error";
+            }
+            if (!error[i].empty()) {
+                buffer.Resize(mark);
+                fprintf(stderr, "test case %d (n=%d, m=%lld) failed: %s", i + 1, size[i].first,
+                        size[i].second, error[i].c_str());
+            }
         }
-        size = std::min(size, node);
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
-        }
-        shuffle(p.begin(), p.end());
-        CycleGraph cycle;
-        cycle.SetDirection(1);
-        std::vector<int> pre(p.begin(), p.begin() + size);
-        cycle.GenGraph(pre);
-        edge = cycle.GetEdge();
-        for (int i = size; i < node; i++) {
-            int f = rnd.next(i);
-            AddEdge(p[f], p[i]);
+        fail_throw = old;
+        if (print_test) {
+            fprintf(out, "%d\n", ok);
         }
-        shuffle(edge.begin(), edge.end());
+        fwrite(buffer.Data(), 1, buffer.Size(), out);
+        return ok;
     }
 };
+
 /**
- * 仙人掌
- * @note 强制设self_loop=0,connect=1,multiply_edge=0,direction=0
- * @note 仙人掌的边数的范围应该是[n-1,n-1+(n-1)/2]
+ * 并行生成一套测试数据，每个文件是一个任务，线程池中空闲的线程领取下一个任务
+ * 每个任务使用自己的随机数生成器，种子由(套件种子,任务编号)决定，输出与线程数和执行顺序无关
+ * @note 任务函数只能使用库内的随机数和自己创建的对象，不能读写任务之间共享的状态
+ * @note 任务内部再开多线程(如RMatGraph::SetThread)时，总线程数为两者之积
  */
-class Cactus : public Graph {
+class Suite {
    private:
-    virtual void JudgeUpper() {
-        int limit = node - 1 + (node - 1) / 2;
-        if (side > limit) {
-            FailGen("number of edges must less than or equal to %d.\n", limit);
-        }
+    struct Job {
+        std::string file;                  // 输出文件
+        std::function<void(Writer&)> gen;  // 生成函数，把数据写入Writer
+        double cost;                       // 预估耗时，只影响领取顺序
+    };
+    long long seed;                  // 套件种子
+    int thread;                      // 线程数
+    std::vector<Job> job;            // 所有任务，下标为任务编号
+    std::vector<std::string> error;  // 每个任务的错误信息，成功时为空
+    std::vector<double> time;        // 每个任务的耗时(秒)
+    /**
+     * 由套件种子和任务编号得到任务的种子(splitmix64)
+     */
+    static long long JobSeed(long long s, int id) {
+        unsigned long long x = (unsigned long long)s + (id + 1) * 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return (long long)((x ^ (x >> 31)) >> 1);
     }
 
    public:
     /**
-     * @param n 结点数
-     * @param m 边数
-     * @note 其余参数默认如下：
-     * @note direction=0 无向图
-     * @note multiply_edge=0 无重边
-     * @note self_loop=0 无自环
-     * @note connect=1 保证连通
+     * @param s 套件种子
+     * @param t 线程数
      */
-    Cactus(int n = 1, int m = 0) {
-        node = n;
-        side = m;
-        direction = 0;
-        multiply_edge = 0;
-        self_loop = 0;
-        connect = 1;
-    }
+    Suite(long long s, int t = DefaultThread()) : seed(s), thread(t) {}
     /**
-     * 强制无向，禁用函数
+     * 设置套件种子
      */
-    void SetDirection(bool f) = delete;
+    void SetSeed(long long s) { seed = s; }
     /**
-     * 强制有无重边，禁用函数
+     * 设置线程数
      */
-    void SetMultiplyEdge(bool f) = delete;
+    void SetThread(int t) { thread = t; }
     /**
-     * 强制无自环，禁用函数
+     * 添加一个任务
+     * @param file 输出文件
+     * @param f 生成函数，参数为Writer&，在函数内创建生成器并把数据写入Writer
+     * @param cost 预估耗时(如边数)，耗时大的任务先领取，使总时间接近最慢的任务
+     * @return 任务编号，决定这个任务的种子
      */
-    void SetSelfLoop(bool f) = delete;
+    int Add(const std::string& file, std::function<void(Writer&)> f, double cost = 1) {
+        job.push_back({file, std::move(f), cost});
+        return job.size() - 1;
+    }
     /**
-     * 强制连通，禁用函数
+     * 获取每个任务的错误信息，成功的任务为空串，生成之后有效
      */
-    void SetConnect(bool f) = delete;
+    std::vector<std::string> GetError() { return error; }
     /**
-     * 生成图
+     * 获取每个任务的耗时(秒)，生成之后有效
      */
-    void GenGraph() {
-        edge.clear();
-        e.clear();
-        JudgeLimits();
-        int m = side;
-        m -= node - 1;
-        std::vector<std::vector<int>> cycle;
-        std::vector<int> p(node);
-        for (int i = 0; i < node; i++) {
-            p[i] = i;
-        }
-        shuffle(p.begin(), p.end());
-        for (int i = 2; i <= 2 * m; i += 2) {
-            std::vector<int> pre;
-            if (i == 2) {
-                pre.push_back(p[0]);
-            }
-            pre.push_back(p[i]);
-            pre.push_back(p[i - 1]);
-            cycle.push_back(pre);
-        }
-        int up = node - (2 * m + 1);
-        int add = rnd.next(0, up);
-        int len = cycle.size();
-        if (len == 0) {
-            add = 0;
-        }
-        for (int i = 2 * m + 1; i <= 2 * m + add; i++) {
-            int w = rnd.next(len);
-            cycle[w].push_back(p[i]);
-        }
-        for (int i = 2 * m + add + 1; i < node; i++) {
-            cycle.push_back({p[i]});
-        }
-        shuffle(cycle.begin() + 1, cycle.end());
-        for (int i = 0; i < cycle.size(); i++) {
-            CycleGraph c;
-            std::vector<int> pre = cycle[i];
-            if (i != 0) {
-                int w = rnd.next(i);
-                pre.push_back(rnd.any(cycle[w]));
-            }
-            c.GenGraph(pre);
-            std::vector<std::pair<int, int>> cycedge = c.GetEdge();
-            edge.insert(edge.end(), cycedge.begin(), cycedge.end());
-        }
-        shuffle(edge.begin(), edge.end());
+    std::vector<double> GetTime() { return time; }
+    /**
+     * 生成所有任务，失败的任务删除输出文件并把错误信息输出到stderr
+     * @return 成功的任务数
+     */
+    int Run() {
+        int n = job.size();
+        error.assign(n, "");
+        time.assign(n, 0);
+        std::vector<int> order(n);
+        for (int i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return job[a].cost > job[b].cost; });
+        std::atomic<int> ok(0);
+        ParallelFor(n, thread, [&](int k) {
+            int i = order[k];
+            auto begin = std::chrono::steady_clock::now();
+            random_t gen;
+            gen.setSeed(JobSeed(seed, i));
+            random_t* old_rnd = thread_rnd;
+            bool old_throw = fail_throw;
+            thread_rnd = &gen;
+            fail_throw = true;
+            FILE* out = fopen(job[i].file.c_str(), "wb");
+            if (out == nullptr) {
+                error[i] = "cannot open " + job[i].file + ".\n";
+            } else {
+                try {
+                    Writer w(out);
+                    job[i].gen(w);
+                } catch (const std::exception& ex) {
+                    error[i] = ex.what();
+                } catch (...) {
+                    error[i] = "unknown error.\n";
+                }
+                if (fclose(out) != 0 && error[i].empty()) {
+                    error[i] = "cannot write " + job[i].file + ".\n";
+                }
+                if (!error[i].empty()) {
+                    remove(job[i].file.c_str());
+                }
+            }
+            thread_rnd = old_rnd;
+            fail_throw = old_throw;
+            time[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            if (error[i].empty()) {
+                ok++;
+            } else {
+                fprintf(stderr, "job %d (%s) failed: %s", i, job[i].file.c_str(), error[i].c_str());
+            }
+        });
+        return ok;
     }
 };
 }  // namespace generator